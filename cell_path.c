@@ -0,0 +1,9 @@
+#include "cell_path.h"
+
+// ===== Conversions =====
+
+void path_to_cell_ids(const Grid* grid, const Path* path, CellId* out) {
+    for (int i = 0; i < path->length; i++) {
+        out[i] = cell_id(grid, path->coordinates[i]);
+    }
+}
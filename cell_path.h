@@ -0,0 +1,35 @@
+#ifndef CELL_PATH_H
+#define CELL_PATH_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Cell-Id Paths =====
+// The evaluation form of a path: linear cell ids, 4 bytes per step instead
+// of 12, equality is a single compare and every id indexes the per-cell
+// tables (cell_data, survivor_map, neighbor_mask) directly. Workers decode
+// shared move strings straight into ids (decode_path_cells) and score them
+// with the *_cells fitness kernels; the master converts a Path once per
+// evaluation with path_to_cell_ids().
+//
+// Scope: Path stays the coordinate genome. The operators step, splice and
+// reverse in x/y/z, shared memory carries move codes rather than either
+// form, and output is written from coordinates. The searches, connector
+// cache and mutation index key cells by id internally. A CellPath never
+// owns its buffer (fitness scratch space, worker stack arrays), so there
+// is no allocation API.
+
+typedef struct {
+    CellId* cells;
+    int length;
+    int capacity;
+    int survivors_reached;
+    int collision_count;
+    float fitness;
+} CellPath;
+
+// Conversion (out-of-grid coordinates become CELL_ID_NONE)
+void path_to_cell_ids(const Grid* grid, const Path* path, CellId* out);
+
+#endif // CELL_PATH_H
@@ -0,0 +1,237 @@
+#include "collapse_events.h"
+#include <fcntl.h>
+
+// ===== Changed-Cell Marks =====
+// Per-cell stamp: (batch << 1) | blocked. A cell belongs to the current
+// batch when its stamp's upper bits equal the batch number, so the table
+// never needs clearing between batches.
+
+static unsigned int* change_stamps = NULL;
+static int change_stamps_size = 0;
+static unsigned int change_batch = 0;
+
+static void mark_changed_cells(const Grid* grid, const CellDelta* deltas, int count) {
+    if (change_stamps_size != grid->total_cells) {
+        free(change_stamps);
+        change_stamps = (unsigned int*)safe_calloc(grid->total_cells, sizeof(unsigned int));
+        change_stamps_size = grid->total_cells;
+        change_batch = 0;
+    }
+
+    change_batch++;
+    for (int i = 0; i < count; i++) {
+        int index = cell_index(grid, deltas[i].coord);
+        change_stamps[index] = (change_batch << 1) | (deltas[i].blocked ? 1u : 0u);
+    }
+}
+
+static int is_changed_cell(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) return 0;
+    return (change_stamps[cell_index(grid, coord)] >> 1) == change_batch;
+}
+
+static int is_newly_blocked(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) return 0;
+    return change_stamps[cell_index(grid, coord)] == ((change_batch << 1) | 1u);
+}
+
+// ===== Event Stream =====
+
+// stdin's flags live on a file description shared with the caller's shell
+// or pipe, so O_NONBLOCK is undone at exit too (error_exit skips
+// close_delta_stream). Forked workers exit through the same handlers; only
+// the process that set the flag restores it.
+static int stdin_saved_flags = -1;
+static pid_t stdin_flags_owner = 0;
+
+static void restore_stdin_flags(void) {
+    if (stdin_saved_flags != -1 && getpid() == stdin_flags_owner) {
+        fcntl(STDIN_FILENO, F_SETFL, stdin_saved_flags);
+        stdin_saved_flags = -1;
+    }
+}
+
+DeltaStream* open_delta_stream(const char* source) {
+    DeltaStream* stream = (DeltaStream*)safe_calloc(1, sizeof(DeltaStream));
+
+    if (strcmp(source, "-") == 0) {
+        stream->fd = STDIN_FILENO;
+        stream->is_stdin = 1;
+        stream->saved_flags = fcntl(stream->fd, F_GETFL);
+        if (stream->saved_flags != -1) {
+            if (stdin_flags_owner == 0) {
+                atexit(restore_stdin_flags);
+            }
+            stdin_saved_flags = stream->saved_flags;
+            stdin_flags_owner = getpid();
+            fcntl(stream->fd, F_SETFL, stream->saved_flags | O_NONBLOCK);
+        }
+    } else {
+        stream->fd = open(source, O_RDONLY | O_NONBLOCK);
+        if (stream->fd == -1) {
+            warning("Could not open collapse event file");
+            free(stream);
+            return NULL;
+        }
+    }
+
+    return stream;
+}
+
+// Parse one event line into a delta; returns 1 on success
+static int parse_delta_line(const char* line, CellDelta* delta) {
+    char kind;
+    Coordinate c;
+
+    if (line[0] == '#' || line[0] == '\0') {
+        return 0;
+    }
+    if (sscanf(line, " %c %d %d %d", &kind, &c.x, &c.y, &c.z) != 4) {
+        fprintf(stderr, "WARNING: Malformed collapse event '%s'\n", line);
+        return 0;
+    }
+
+    if (kind == 'B' || kind == 'b') delta->blocked = 1;
+    else if (kind == 'C' || kind == 'c') delta->blocked = 0;
+    else {
+        fprintf(stderr, "WARNING: Unknown collapse event type '%c'\n", kind);
+        return 0;
+    }
+
+    delta->coord = c;
+    return 1;
+}
+
+// Non-blocking: returns the events that are complete lines right now.
+// A regular file is followed like "tail -f"; new lines are read next call.
+int read_delta_stream(DeltaStream* stream, CellDelta* deltas, int max_deltas) {
+    if (!stream) return 0;
+
+    int count = 0;
+    while (count < max_deltas) {
+        // Parse complete lines already buffered
+        char* newline = memchr(stream->buffer, '\n', stream->buffered);
+        if (newline) {
+            *newline = '\0';
+            if (newline > stream->buffer && newline[-1] == '\r') newline[-1] = '\0';
+            if (parse_delta_line(stream->buffer, &deltas[count])) {
+                count++;
+            }
+
+            int consumed = (int)(newline - stream->buffer) + 1;
+            memmove(stream->buffer, newline + 1, stream->buffered - consumed);
+            stream->buffered -= consumed;
+            continue;
+        }
+
+        if (stream->buffered == DELTA_LINE_BUFFER) {
+            warning("Collapse event line too long, discarding");
+            stream->buffered = 0;
+        }
+
+        ssize_t bytes = read(stream->fd, stream->buffer + stream->buffered,
+                             DELTA_LINE_BUFFER - stream->buffered);
+        if (bytes <= 0) {
+            break;  // EOF for now, or EAGAIN on an idle pipe
+        }
+        stream->buffered += (int)bytes;
+    }
+
+    return count;
+}
+
+void close_delta_stream(DeltaStream* stream) {
+    if (!stream) return;
+
+    if (stream->is_stdin) {
+        restore_stdin_flags();
+    } else {
+        close(stream->fd);
+    }
+    free(stream);
+}
+
+// ===== Population Repair =====
+
+// Replace runs of newly blocked steps with an A* detour between the
+// surrounding steps. If no detour exists, the path is cut before the run.
+static void repair_blocked_steps(Path* path, const Grid* grid) {
+    Path* repaired = create_path(path->capacity);
+    int i = 0;
+
+    while (i < path->length) {
+        Coordinate coord = path->coordinates[i];
+        if (!is_newly_blocked(grid, coord)) {
+            add_coordinate_to_path(repaired, coord);
+            i++;
+            continue;
+        }
+
+        int run_end = i;
+        while (run_end < path->length && is_newly_blocked(grid, path->coordinates[run_end])) {
+            run_end++;
+        }
+
+        // Blocked tail or no anchor before the run: drop the rest
+        if (run_end >= path->length || repaired->length == 0) {
+            break;
+        }
+
+        Coordinate from = repaired->coordinates[repaired->length - 1];
+        Coordinate to = path->coordinates[run_end];
+        Path* detour = connect_coordinates(grid, from, to, NULL);
+        if (!detour) {
+            break;
+        }
+        for (int k = 1; k < detour->length - 1; k++) {
+            add_coordinate_to_path(repaired, detour->coordinates[k]);
+        }
+        free_path(detour);
+        i = run_end;
+    }
+
+    // Copy the repaired coordinates back (the path may live in a
+    // generation arena, so its buffer is not swapped out)
+    path->length = 0;
+    reserve_path_capacity(path, repaired->length);
+    memcpy(path->coordinates, repaired->coordinates, repaired->length * sizeof(Coordinate));
+    path->length = repaired->length;
+    free_path(repaired);
+}
+
+int repair_population(Path** population, int pop_size, const Grid* grid,
+                      const Config* config, const CellDelta* deltas, int count,
+                      int rescore_all) {
+    if (!population || count <= 0) return 0;
+
+    mark_changed_cells(grid, deltas, count);
+
+    int touched = 0;
+    for (int p = 0; p < pop_size; p++) {
+        Path* path = population[p];
+        int affected = 0;
+        int blocked = 0;
+
+        for (int i = 0; i < path->length; i++) {
+            Coordinate coord = path->coordinates[i];
+            if (!is_changed_cell(grid, coord)) {
+                continue;
+            }
+            affected = 1;
+            if (is_newly_blocked(grid, coord)) {
+                blocked = 1;
+                break;
+            }
+        }
+
+        if (!affected && !rescore_all) continue;
+
+        if (blocked) {
+            repair_blocked_steps(path, grid);
+        }
+        update_path_fitness(path, grid, config);
+        touched++;
+    }
+
+    return touched;
+}
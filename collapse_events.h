@@ -0,0 +1,40 @@
+#ifndef COLLAPSE_EVENTS_H
+#define COLLAPSE_EVENTS_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+#include "fitness.h"
+
+// ===== Collapse Event Stream =====
+// One event per line, read from a file (appended to while running) or
+// from stdin ("-"):
+//   B x y z   - cell becomes blocked (collapse)
+//   C x y z   - cell is cleared
+// Lines starting with '#' are ignored.
+
+#define MAX_DELTAS_PER_BATCH 1024
+#define DELTA_LINE_BUFFER 4096
+
+typedef struct {
+    int fd;
+    int is_stdin;
+    int saved_flags;                 // stdin flags restored on close
+    char buffer[DELTA_LINE_BUFFER];  // Partial line carried between reads
+    int buffered;
+} DeltaStream;
+
+DeltaStream* open_delta_stream(const char* source);
+int read_delta_stream(DeltaStream* stream, CellDelta* deltas, int max_deltas);
+void close_delta_stream(DeltaStream* stream);
+
+// ===== Population Repair =====
+// Re-stitches paths that cross newly blocked cells and re-evaluates only the
+// paths whose coordinates touch a changed cell. Fitness is normalized by
+// grid->reachable_survivors, so when the batch changed that count
+// (rescore_all) every path is re-evaluated. Returns the number touched.
+int repair_population(Path** population, int pop_size, const Grid* grid,
+                      const Config* config, const CellDelta* deltas, int count,
+                      int rescore_all);
+
+#endif // COLLAPSE_EVENTS_H
@@ -0,0 +1,338 @@
+#include "connector_cache.h"
+
+// ===== Shared Segment Layout =====
+// [ConnectorCacheStats header][int buckets[num_buckets]]
+// [ConnectorEntry entries[capacity]][int cells[capacity * MAX_CELLS]]
+// Everything is addressed by index, never by pointer, so the layout is
+// valid at any attach address.
+
+static int cache_shm_id = -1;
+static int cache_sem_id = -1;
+static ConnectorCacheStats* header = NULL;
+static int* buckets = NULL;
+static ConnectorEntry* entries = NULL;
+static int* slots = NULL;
+
+static void cache_lock(void) {
+    struct sembuf sb = {0, -1, 0};
+    if (semop(cache_sem_id, &sb, 1) == -1) {
+        perror("connector cache lock failed");
+    }
+}
+
+static void cache_unlock(void) {
+    struct sembuf sb = {0, 1, 0};
+    if (semop(cache_sem_id, &sb, 1) == -1) {
+        perror("connector cache unlock failed");
+    }
+}
+
+static void clear_entries(void) {
+    for (int b = 0; b < header->num_buckets; b++) {
+        buckets[b] = -1;
+    }
+    for (int e = 0; e < header->capacity; e++) {
+        entries[e].length = 0;
+        entries[e].next = -1;
+        entries[e].referenced = 0;
+    }
+    header->clock_hand = 0;
+    header->used = 0;
+}
+
+// ===== Setup =====
+
+// Create and attach the shared cache (call before workers are forked)
+int create_connector_cache(int capacity) {
+    if (capacity <= 0) return -1;
+
+    int num_buckets = 1;
+    while (num_buckets < capacity * 2) num_buckets <<= 1;
+
+    size_t bytes = sizeof(ConnectorCacheStats) +
+                   (size_t)num_buckets * sizeof(int) +
+                   (size_t)capacity * sizeof(ConnectorEntry) +
+                   (size_t)capacity * CONNECTOR_CACHE_MAX_CELLS * sizeof(int);
+
+    key_t shm_key = ftok(".", 'C');
+    key_t sem_key = ftok(".", 'L');
+    if (shm_key == -1 || sem_key == -1) {
+        perror("ftok failed");
+        return -1;
+    }
+
+    cache_shm_id = shmget(shm_key, bytes, IPC_CREAT | 0666);
+    if (cache_shm_id == -1) {
+        perror("shmget failed for connector cache");
+        return -1;
+    }
+
+    void* base = shmat(cache_shm_id, NULL, 0);
+    if (base == (void*)-1) {
+        perror("shmat failed for connector cache");
+        shmctl(cache_shm_id, IPC_RMID, NULL);
+        cache_shm_id = -1;
+        return -1;
+    }
+
+    cache_sem_id = semget(sem_key, 1, IPC_CREAT | 0666);
+    if (cache_sem_id == -1 || semctl(cache_sem_id, 0, SETVAL, 1) == -1) {
+        perror("semget failed for connector cache");
+        shmdt(base);
+        shmctl(cache_shm_id, IPC_RMID, NULL);
+        cache_shm_id = -1;
+        return -1;
+    }
+
+    header = (ConnectorCacheStats*)base;
+    buckets = (int*)(header + 1);
+    entries = (ConnectorEntry*)(buckets + num_buckets);
+    slots = (int*)(entries + capacity);
+
+    memset(header, 0, sizeof(ConnectorCacheStats));
+    header->capacity = capacity;
+    header->num_buckets = num_buckets;
+    header->grid_version = -1;
+    header->bytes = bytes;
+    clear_entries();
+    return 0;
+}
+
+void destroy_connector_cache(void) {
+    if (!header) return;
+
+    shmdt(header);
+    if (shmctl(cache_shm_id, IPC_RMID, NULL) == -1) {
+        perror("shmctl IPC_RMID failed for connector cache");
+    }
+    if (semctl(cache_sem_id, 0, IPC_RMID) == -1) {
+        perror("semctl IPC_RMID failed for connector cache");
+    }
+
+    header = NULL;
+    buckets = NULL;
+    entries = NULL;
+    slots = NULL;
+    cache_shm_id = -1;
+    cache_sem_id = -1;
+}
+
+int connector_cache_enabled(void) {
+    return header != NULL;
+}
+
+// ===== Hashing =====
+
+static inline int bucket_of(int low, int high) {
+    uint32_t h = (uint32_t)low * 0x9E3779B1u ^ (uint32_t)high * 0x85EBCA77u;
+    h ^= h >> 15;
+    return (int)(h & (uint32_t)(header->num_buckets - 1));
+}
+
+static int find_entry(int low, int high) {
+    for (int e = buckets[bucket_of(low, high)]; e >= 0; e = entries[e].next) {
+        if (entries[e].from_cell == low && entries[e].to_cell == high) return e;
+    }
+    return -1;
+}
+
+static void unlink_entry(int e) {
+    int* link = &buckets[bucket_of(entries[e].from_cell, entries[e].to_cell)];
+    while (*link != e) link = &entries[*link].next;
+    *link = entries[e].next;
+    entries[e].next = -1;
+    entries[e].length = 0;
+    header->used--;
+}
+
+// Second-chance sweep: skip (and clear) referenced entries, take the first
+// empty or unreferenced one
+static int claim_entry(void) {
+    for (;;) {
+        int e = header->clock_hand;
+        header->clock_hand = (e + 1) % header->capacity;
+
+        if (entries[e].length == 0) return e;
+        if (entries[e].referenced) {
+            entries[e].referenced = 0;
+            continue;
+        }
+        unlink_entry(e);
+        header->evictions++;
+        return e;
+    }
+}
+
+// Entries found on an older grid are dropped as soon as a newer version
+// shows up. Returns 0 when the caller's grid is older than the cache.
+static int sync_version(const Grid* grid) {
+    if (header->grid_version == grid->version) return 1;
+    if (grid->version < header->grid_version) return 0;
+
+    if (header->used > 0) header->invalidations++;
+    clear_entries();
+    header->grid_version = grid->version;
+    return 1;
+}
+
+// ===== Lookups =====
+
+// Cached connector from 'from_cell' to 'to_cell', or NULL on a miss
+Path* connector_cache_lookup(const Grid* grid, int from_cell, int to_cell) {
+    if (!header) return NULL;
+
+    int reversed = from_cell > to_cell;
+    int low = reversed ? to_cell : from_cell;
+    int high = reversed ? from_cell : to_cell;
+
+    cache_lock();
+    int e = sync_version(grid) ? find_entry(low, high) : -1;
+    if (e < 0) {
+        header->misses++;
+        cache_unlock();
+        return NULL;
+    }
+
+    const int* cells = slots + (size_t)e * CONNECTOR_CACHE_MAX_CELLS;
+    int length = entries[e].length;
+    Path* path = create_path(length);
+    for (int i = 0; i < length; i++) {
+        int cell = cells[reversed ? length - 1 - i : i];
+        path->coordinates[i] = cell_coordinate(grid, cell);
+    }
+    path->length = length;
+    entries[e].referenced = 1;
+    header->hits++;
+    cache_unlock();
+
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
+
+void connector_cache_store(const Grid* grid, int from_cell, int to_cell,
+                           const Path* path) {
+    if (!header || !path || path->length <= 0 ||
+        path->length > CONNECTOR_CACHE_MAX_CELLS) {
+        return;
+    }
+
+    int reversed = from_cell > to_cell;
+    int low = reversed ? to_cell : from_cell;
+    int high = reversed ? from_cell : to_cell;
+
+    cache_lock();
+    if (!sync_version(grid) || find_entry(low, high) >= 0) {
+        cache_unlock();
+        return;
+    }
+
+    int e = claim_entry();
+    int* cells = slots + (size_t)e * CONNECTOR_CACHE_MAX_CELLS;
+    int length = path->length;
+    for (int i = 0; i < length; i++) {
+        Coordinate c = path->coordinates[reversed ? length - 1 - i : i];
+        cells[i] = cell_index(grid, c);
+    }
+
+    int b = bucket_of(low, high);
+    entries[e].from_cell = low;
+    entries[e].to_cell = high;
+    entries[e].length = length;
+    entries[e].referenced = 0;
+    entries[e].next = buckets[b];
+    buckets[b] = e;
+    header->used++;
+    header->insertions++;
+    cache_unlock();
+}
+
+// ===== Grid Changes =====
+
+// Per-process stamp over the grid cells: blocked_stamp[cell] equals
+// blocked_batch while the cell is blocked by the batch being applied
+static unsigned int* blocked_stamp = NULL;
+static int blocked_stamp_size = 0;
+static unsigned int blocked_batch = 0;
+
+static int entry_is_stale(const Grid* grid, int e, const int* cleared, int cleared_count) {
+    const int* cells = slots + (size_t)e * CONNECTOR_CACHE_MAX_CELLS;
+    int length = entries[e].length;
+    for (int i = 0; i < length; i++) {
+        if (blocked_stamp[cells[i]] == blocked_batch) return 1;
+    }
+
+    // A route through a cleared cell is at least the Manhattan distance
+    // there and on; only a shorter one can replace the cached connector
+    Coordinate from = cell_coordinate(grid, entries[e].from_cell);
+    Coordinate to = cell_coordinate(grid, entries[e].to_cell);
+    for (int i = 0; i < cleared_count; i++) {
+        Coordinate c = cell_coordinate(grid, cleared[i]);
+        if (manhattan_distance(from, c) + manhattan_distance(c, to) < length - 1) return 1;
+    }
+    return 0;
+}
+
+// Called after a delta batch moved the grid from base_version to its
+// current version. Only a cache still at base_version can be patched; a
+// cache already at the new version was patched by another process.
+void update_connector_cache(const Grid* grid, const CellDelta* deltas, int count,
+                            int base_version) {
+    if (!header || count <= 0) return;
+
+    if (blocked_stamp_size != grid->total_cells) {
+        free(blocked_stamp);
+        blocked_stamp = (unsigned int*)safe_calloc(grid->total_cells, sizeof(unsigned int));
+        blocked_stamp_size = grid->total_cells;
+        blocked_batch = 0;
+    }
+    blocked_batch++;
+
+    // A cell repeated in the batch counts with its final state
+    int* cleared = (int*)safe_malloc(count * sizeof(int));
+    int cleared_count = 0;
+    for (int i = 0; i < count; i++) {
+        int cell = cell_index(grid, deltas[i].coord);
+        if (grid->cell_data[cell] == CELL_OBSTACLE) blocked_stamp[cell] = blocked_batch;
+        else cleared[cleared_count++] = cell;
+    }
+
+    cache_lock();
+    if (header->grid_version == base_version) {
+        for (int e = 0; e < header->capacity; e++) {
+            if (entries[e].length == 0) continue;
+            if (entry_is_stale(grid, e, cleared, cleared_count)) {
+                unlink_entry(e);
+                header->stale_entries++;
+            }
+        }
+        header->grid_version = grid->version;
+    } else if (header->grid_version < base_version) {
+        sync_version(grid);
+    }
+    cache_unlock();
+
+    free(cleared);
+}
+
+// ===== Statistics =====
+
+int get_connector_cache_stats(ConnectorCacheStats* stats) {
+    if (!header) return 0;
+    cache_lock();
+    *stats = *header;
+    cache_unlock();
+    return 1;
+}
+
+void print_connector_cache_stats(void) {
+    ConnectorCacheStats stats;
+    if (!get_connector_cache_stats(&stats)) return;
+
+    long long lookups = stats.hits + stats.misses;
+    printf("Connector Cache: %lld/%lld hits (%.1f%%), %d/%d entries, "
+           "%lld evictions, %lld stale after collapses, %lld invalidations, %.1f KB shared\n",
+           stats.hits, lookups,
+           lookups > 0 ? 100.0 * stats.hits / lookups : 0.0,
+           stats.used, stats.capacity, stats.evictions, stats.stale_entries,
+           stats.invalidations, stats.bytes / 1024.0);
+}
@@ -0,0 +1,64 @@
+#ifndef CONNECTOR_CACHE_H
+#define CONNECTOR_CACHE_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Shared Connector Cache =====
+// Bounded cache of connector paths (the shortest paths crossover and repair
+// splice between two path fragments), keyed by the unordered pair of
+// endpoint cells. It lives in its own SysV shared memory segment guarded by
+// its own semaphore, so every process forked after creation shares hits.
+//
+// Each entry owns a fixed slot of CONNECTOR_CACHE_MAX_CELLS cells; longer
+// connectors are not cached. Eviction is CLOCK (second chance).
+//
+// apply_obstacle_deltas() patches the cache per batch: an entry is dropped
+// when one of its cells was blocked, or when a cleared cell is close enough
+// to both endpoints to open a shorter route. The rest are still valid and
+// no longer than before. Any other grid change (a caller presenting a
+// version the cache was not patched to) drops the whole cache.
+
+#define CONNECTOR_CACHE_MAX_CELLS 256
+
+typedef struct {
+    int from_cell;           // Lower endpoint cell (the path runs from it)
+    int to_cell;             // Higher endpoint cell
+    int length;              // Cells in the slot, 0 = empty entry
+    int next;                // Next entry in the hash chain, -1 = end
+    int referenced;          // CLOCK reference bit
+} ConnectorEntry;
+
+typedef struct {
+    int capacity;            // Entries
+    int num_buckets;         // Power of two
+    int grid_version;        // Grid version the entries were found on
+    int clock_hand;
+    int used;
+    long long hits;
+    long long misses;
+    long long insertions;
+    long long evictions;
+    long long invalidations;  // Whole-cache drops
+    long long stale_entries;  // Entries dropped by delta batches
+    size_t bytes;            // Size of the shared segment
+} ConnectorCacheStats;
+
+// ===== Setup =====
+int create_connector_cache(int capacity);
+void destroy_connector_cache(void);
+int connector_cache_enabled(void);
+
+// ===== Lookups =====
+Path* connector_cache_lookup(const Grid* grid, int from_cell, int to_cell);
+void connector_cache_store(const Grid* grid, int from_cell, int to_cell,
+                           const Path* path);
+void update_connector_cache(const Grid* grid, const CellDelta* deltas, int count,
+                            int base_version);
+
+// ===== Statistics =====
+int get_connector_cache_stats(ConnectorCacheStats* stats);
+void print_connector_cache_stats(void);
+
+#endif // CONNECTOR_CACHE_H
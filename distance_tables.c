@@ -0,0 +1,333 @@
+#include "distance_tables.h"
+
+// ===== Packed Direction Fields =====
+
+static inline unsigned char* field_of(const DistanceTable* table, int source) {
+    return table->directions + (size_t)source * table->bytes_per_field;
+}
+
+static inline int get_nibble(const unsigned char* field, int cell) {
+    unsigned char byte = field[cell >> 1];
+    return (cell & 1) ? (byte >> 4) : (byte & 0x0F);
+}
+
+static inline void set_nibble(unsigned char* field, int cell, int value) {
+    unsigned char* byte = &field[cell >> 1];
+    if (cell & 1) *byte = (unsigned char)((*byte & 0x0F) | (value << 4));
+    else *byte = (unsigned char)((*byte & 0xF0) | value);
+}
+
+// ===== Construction =====
+
+// Level-by-level BFS from one source. Each newly reached cell records the
+// direction back toward the cell it was reached from; 'level' receives the
+// hop count of every reached cell (stamped with 'stamp').
+static void sweep_from_source(const Grid* grid, DistanceTable* table, int source,
+                              const int* offsets, int* queue, int* level,
+                              unsigned int* seen, unsigned int stamp) {
+    unsigned char* field = field_of(table, source);
+    int origin = table->source_cell[source];
+
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = origin;
+    seen[origin] = stamp;
+    level[origin] = 0;
+
+    while (head < tail) {
+        int cell = queue[head++];
+        unsigned char mask = grid->neighbor_mask[cell];
+
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(mask & (1 << d))) continue;
+
+            int next = cell + offsets[d];
+            if (seen[next] == stamp) continue;
+
+            seen[next] = stamp;
+            level[next] = level[cell] + 1;
+            set_nibble(field, next, d ^ 1);
+            queue[tail++] = next;
+        }
+    }
+}
+
+// Row and column 'source' of the source-to-source matrix from its sweep
+static void store_source_distances(DistanceTable* table, int source, const int* level,
+                                   const unsigned int* seen, unsigned int stamp) {
+    int n = table->num_sources;
+    for (int t = 0; t < n; t++) {
+        int cell = table->source_cell[t];
+        int d = (seen[cell] == stamp) ? level[cell] : -1;
+        table->distance[source * n + t] = d;
+        table->distance[t * n + source] = d;
+    }
+}
+
+DistanceTable* build_distance_table(const Grid* grid) {
+    DistanceTable* table = (DistanceTable*)safe_malloc(sizeof(DistanceTable));
+    table->num_sources = grid->num_survivors + 1;
+    table->start_source = grid->num_survivors;
+    table->num_cells = grid->total_cells;
+    table->bytes_per_field = (grid->total_cells + 1) / 2;
+    table->grid_version = grid->version;
+
+    int n = table->num_sources;
+    table->distance = (int*)safe_malloc(n * n * sizeof(int));
+    table->source_cell = (int*)safe_malloc(n * sizeof(int));
+    table->directions = (unsigned char*)safe_malloc((size_t)n * table->bytes_per_field);
+    memset(table->directions, 0xFF, (size_t)n * table->bytes_per_field);
+
+    for (int s = 0; s < grid->num_survivors; s++) {
+        table->source_cell[s] = cell_index(grid, grid->survivors[s]);
+    }
+    table->source_cell[table->start_source] = cell_index(grid, grid->start);
+
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int* level = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    unsigned int* seen = (unsigned int*)safe_calloc(grid->total_cells, sizeof(unsigned int));
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    for (int s = 0; s < n; s++) {
+        unsigned int stamp = (unsigned int)s + 1;
+        sweep_from_source(grid, table, s, offsets, queue, level, seen, stamp);
+        store_source_distances(table, s, level, seen, stamp);
+    }
+
+    free(queue);
+    free(level);
+    free(seen);
+    return table;
+}
+
+void free_distance_table(DistanceTable* table) {
+    if (!table) return;
+    free(table->distance);
+    free(table->source_cell);
+    free(table->directions);
+    free(table);
+}
+
+// Cached on the grid. Collapse batches are patched in by
+// update_distance_table(); any other layout or survivor change rebuilds.
+const DistanceTable* get_distance_table(const Grid* grid) {
+    Grid* cache = (Grid*)grid;
+    DistanceTable* table = cache->distances;
+
+    if (!table || table->grid_version != grid->version ||
+        table->num_sources != grid->num_survivors + 1 ||
+        table->num_cells != grid->total_cells) {
+        free_distance_table(table);
+        cache->distances = build_distance_table(grid);
+    }
+    return cache->distances;
+}
+
+// ===== Incremental Update =====
+// A batch of deltas usually leaves most fields valid. Blocking a cell only
+// matters to a source whose tree passes through it, and then only if one of
+// its children has no other neighbour one hop closer to the source; such
+// children are re-pointed in place. A cleared cell changes nothing as long
+// as its walkable neighbours were all reached and lie within two hops of
+// each other; it just joins the tree. Any other case, or a repair that
+// walks more cells than a sweep would visit, re-sweeps that source alone.
+
+// Hops from 'cell' to the source along its field; -1 when the walk drops
+// off the tree, exceeds 'limit' hops or exhausts '*budget'
+static int field_level(const DistanceTable* table, int source, int cell,
+                       const int* offsets, int limit, long* budget) {
+    const unsigned char* field = field_of(table, source);
+    int origin = table->source_cell[source];
+    int hops = 0;
+
+    while (cell != origin) {
+        int d = get_nibble(field, cell);
+        if (d == DIRECTION_NONE || hops >= limit || --(*budget) < 0) return -1;
+        cell += offsets[d];
+        hops++;
+    }
+    return hops;
+}
+
+static int repair_blocked_cell(const Grid* grid, DistanceTable* table, int source,
+                               int cell, const int* offsets, long* budget) {
+    unsigned char* field = field_of(table, source);
+    if (get_nibble(field, cell) == DIRECTION_NONE) return 1;
+
+    int level = field_level(table, source, cell, offsets, table->num_cells, budget);
+    if (level < 0) return 0;
+
+    unsigned char mask = grid->neighbor_mask[cell];
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(mask & (1 << d))) continue;
+        int child = cell + offsets[d];
+        if (get_nibble(field, child) != (d ^ 1)) continue;
+
+        // Another parent at the same level keeps every distance below it
+        unsigned char child_mask = grid->neighbor_mask[child];
+        int parent_dir = -1;
+        for (int e = 0; e < NUM_DIRECTIONS && parent_dir < 0; e++) {
+            if (!(child_mask & (1 << e))) continue;
+            if (field_level(table, source, child + offsets[e], offsets, level, budget) == level) {
+                parent_dir = e;
+            }
+            if (*budget < 0) return 0;
+        }
+        if (parent_dir < 0) return 0;
+        set_nibble(field, child, parent_dir);
+    }
+
+    set_nibble(field, cell, DIRECTION_NONE);
+    return 1;
+}
+
+static int repair_cleared_cell(const Grid* grid, DistanceTable* table, int source,
+                               int cell, const int* offsets, long* budget) {
+    unsigned char* field = field_of(table, source);
+    unsigned char mask = grid->neighbor_mask[cell];
+    int nearest = -1;
+    int nearest_dir = -1;
+    int farthest = -1;
+    int unreached = 0;
+
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(mask & (1 << d))) continue;
+        int level = field_level(table, source, cell + offsets[d], offsets,
+                                table->num_cells, budget);
+        if (*budget < 0) return 0;
+        if (level < 0) {
+            unreached = 1;
+            continue;
+        }
+        if (nearest < 0 || level < nearest) {
+            nearest = level;
+            nearest_dir = d;
+        }
+        if (level > farthest) farthest = level;
+    }
+
+    if (nearest < 0) return 1;                    // Still cut off from the source
+    if (unreached || farthest > nearest + 2) return 0;
+    set_nibble(field, cell, nearest_dir);
+    return 1;
+}
+
+static int repair_source(const Grid* grid, DistanceTable* table, int source,
+                         const CellDelta* deltas, int count, const int* offsets) {
+    long budget = table->num_cells;
+
+    // Blocks first: cleared cells are still off the tree while they run
+    for (int i = 0; i < count; i++) {
+        if (!deltas[i].blocked) continue;
+        int cell = cell_index(grid, deltas[i].coord);
+        if (!repair_blocked_cell(grid, table, source, cell, offsets, &budget)) return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (deltas[i].blocked) continue;
+        int cell = cell_index(grid, deltas[i].coord);
+        if (!repair_cleared_cell(grid, table, source, cell, offsets, &budget)) return 0;
+    }
+    return 1;
+}
+
+// 'deltas' are the distinct cells apply_obstacle_deltas() changed, taking
+// the grid from 'base_version' to its current version. A table built for
+// any other version is left for get_distance_table() to rebuild.
+void update_distance_table(Grid* grid, const CellDelta* deltas, int count, int base_version) {
+    DistanceTable* table = grid->distances;
+    if (!table || table->grid_version != base_version ||
+        table->num_sources != grid->num_survivors + 1 ||
+        table->num_cells != grid->total_cells) {
+        return;
+    }
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    int* queue = NULL;
+    int* level = NULL;
+    unsigned int* seen = NULL;
+
+    for (int s = 0; s < table->num_sources; s++) {
+        if (repair_source(grid, table, s, deltas, count, offsets)) continue;
+
+        if (!queue) {
+            queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+            level = (int*)safe_malloc(grid->total_cells * sizeof(int));
+            seen = (unsigned int*)safe_calloc(grid->total_cells, sizeof(unsigned int));
+        }
+        unsigned int stamp = (unsigned int)s + 1;
+        memset(field_of(table, s), 0xFF, table->bytes_per_field);
+        sweep_from_source(grid, table, s, offsets, queue, level, seen, stamp);
+        store_source_distances(table, s, level, seen, stamp);
+    }
+
+    free(queue);
+    free(level);
+    free(seen);
+    table->grid_version = grid->version;
+}
+
+size_t distance_table_bytes(const DistanceTable* table) {
+    if (!table) return 0;
+    size_t n = (size_t)table->num_sources;
+    return sizeof(DistanceTable) + n * n * sizeof(int) + n * sizeof(int) +
+           n * table->bytes_per_field;
+}
+
+// ===== Lookups =====
+
+// Shortest walkable distance between two sources (-1 = unreachable)
+int source_distance(const DistanceTable* table, int from_source, int to_source) {
+    return table->distance[from_source * table->num_sources + to_source];
+}
+
+// Direction (0-5) of the next step from 'cell' toward the source;
+// DIRECTION_NONE at the source itself or when it cannot be reached
+int direction_to_source(const DistanceTable* table, int source, int cell) {
+    return get_nibble(field_of(table, source), cell);
+}
+
+// Steps from an arbitrary cell to a source by walking its field.
+// Returns -1 if unreachable or longer than 'limit' (limit < 0 = no limit).
+int walk_distance_to_source(const Grid* grid, const DistanceTable* table,
+                            Coordinate from, int source, int limit) {
+    const unsigned char* field = field_of(table, source);
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    int cell = cell_index(grid, from);
+    int target = table->source_cell[source];
+    int steps = 0;
+
+    while (cell != target) {
+        int d = get_nibble(field, cell);
+        if (d == DIRECTION_NONE) return -1;
+        if (limit >= 0 && steps >= limit) return -1;
+        cell += offsets[d];
+        steps++;
+    }
+    return steps;
+}
+
+// Shortest path from 'from' to the source, both endpoints included
+Path* path_to_source(const Grid* grid, const DistanceTable* table,
+                     Coordinate from, int source) {
+    int steps = walk_distance_to_source(grid, table, from, source, -1);
+    if (steps < 0) return NULL;
+
+    const unsigned char* field = field_of(table, source);
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    Path* path = create_path(steps + 1);
+    int cell = cell_index(grid, from);
+    path->coordinates[path->length++] = from;
+    for (int i = 0; i < steps; i++) {
+        cell += offsets[get_nibble(field, cell)];
+        path->coordinates[path->length++] = cell_coordinate(grid, cell);
+    }
+
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
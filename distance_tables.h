@@ -0,0 +1,46 @@
+#ifndef DISTANCE_TABLES_H
+#define DISTANCE_TABLES_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Survivor Distance Tables =====
+// One breadth-first sweep from every survivor and from the start cell.
+// Sources are numbered 0..num_survivors-1 (survivor index) and
+// num_survivors (the start cell).
+//
+// Per source, every cell stores a 4-bit direction pointing one step
+// closer to that source (two cells per byte), so the shortest path from
+// any walkable cell to any source is a walk along the field.
+
+#define DIRECTION_NONE 0xF   // Unreachable from the source (or the source itself)
+
+struct DistanceTable {
+    int num_sources;
+    int start_source;            // Source index of the start cell
+    int num_cells;
+    int bytes_per_field;         // (num_cells + 1) / 2
+    int grid_version;            // Grid version the tables were built for
+    int* distance;               // num_sources x num_sources, -1 = unreachable
+    int* source_cell;            // Cell index of each source
+    unsigned char* directions;   // num_sources packed direction fields
+};
+typedef struct DistanceTable DistanceTable;
+
+// ===== Construction =====
+DistanceTable* build_distance_table(const Grid* grid);
+void free_distance_table(DistanceTable* table);
+const DistanceTable* get_distance_table(const Grid* grid);
+void update_distance_table(Grid* grid, const CellDelta* deltas, int count, int base_version);
+size_t distance_table_bytes(const DistanceTable* table);
+
+// ===== Lookups =====
+int source_distance(const DistanceTable* table, int from_source, int to_source);
+int direction_to_source(const DistanceTable* table, int source, int cell);
+int walk_distance_to_source(const Grid* grid, const DistanceTable* table,
+                            Coordinate from, int source, int limit);
+Path* path_to_source(const Grid* grid, const DistanceTable* table,
+                     Coordinate from, int source);
+
+#endif // DISTANCE_TABLES_H
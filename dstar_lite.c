@@ -0,0 +1,314 @@
+#include "dstar_lite.h"
+#include <limits.h>
+
+#define DSTAR_INF (INT_MAX / 4)
+
+struct Replanner {
+    int num_cells;
+    int grid_version;        // Grid version the search state reflects
+    int initialized;
+    int last_start;          // Robot cell at the previous replan
+    int km;                  // Heuristic offset accumulated by robot moves
+    uint64_t targets;
+    long long expansions;
+
+    int* g;
+    int* rhs;
+    unsigned char* walkable; // Walkability the search state was built on
+    unsigned char* goal;
+
+    // Indexed min-heap on (k1, k2) packed into one 64-bit key
+    int* heap;
+    int* position;           // -1 = not queued
+    uint64_t* key;
+    int heap_size;
+
+    int offsets[NUM_DIRECTIONS];
+    Coordinate start;        // Heuristic anchor for this replan
+};
+
+// ===== Key Heap =====
+
+static void key_place(Replanner* p, int slot, int cell) {
+    p->heap[slot] = cell;
+    p->position[cell] = slot;
+}
+
+static void key_sift_up(Replanner* p, int slot) {
+    int cell = p->heap[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (p->key[p->heap[parent]] <= p->key[cell]) break;
+        key_place(p, slot, p->heap[parent]);
+        slot = parent;
+    }
+    key_place(p, slot, cell);
+}
+
+static void key_sift_down(Replanner* p, int slot) {
+    int cell = p->heap[slot];
+    for (;;) {
+        int child = 2 * slot + 1;
+        if (child >= p->heap_size) break;
+        if (child + 1 < p->heap_size && p->key[p->heap[child + 1]] < p->key[p->heap[child]]) {
+            child++;
+        }
+        if (p->key[p->heap[child]] >= p->key[cell]) break;
+        key_place(p, slot, p->heap[child]);
+        slot = child;
+    }
+    key_place(p, slot, cell);
+}
+
+// Insert, or move an already queued cell to its new key
+static void key_update(Replanner* p, int cell, uint64_t key) {
+    int slot = p->position[cell];
+    if (slot < 0) {
+        p->key[cell] = key;
+        slot = p->heap_size++;
+        key_place(p, slot, cell);
+        key_sift_up(p, slot);
+        return;
+    }
+
+    uint64_t old = p->key[cell];
+    p->key[cell] = key;
+    if (key < old) key_sift_up(p, slot);
+    else key_sift_down(p, slot);
+}
+
+static void key_remove(Replanner* p, int cell) {
+    int slot = p->position[cell];
+    if (slot < 0) return;
+
+    p->position[cell] = -1;
+    p->heap_size--;
+    if (slot == p->heap_size) return;
+
+    int last = p->heap[p->heap_size];
+    key_place(p, slot, last);
+    key_sift_up(p, slot);
+    key_sift_down(p, p->position[last]);
+}
+
+// ===== D* Lite Core =====
+
+static inline int heuristic(const Replanner* p, const Grid* grid, int cell) {
+    return manhattan_distance(p->start, cell_coordinate(grid, cell));
+}
+
+static inline uint64_t calculate_key(const Replanner* p, const Grid* grid, int cell) {
+    int best = p->g[cell] < p->rhs[cell] ? p->g[cell] : p->rhs[cell];
+    uint64_t k1 = (uint64_t)(best + heuristic(p, grid, cell) + p->km);
+    return (k1 << 32) | (uint64_t)best;
+}
+
+static int compute_rhs(const Replanner* p, const Grid* grid, int cell) {
+    if (p->goal[cell]) return 0;
+    if (!p->walkable[cell]) return DSTAR_INF;
+
+    int best = DSTAR_INF;
+    unsigned char mask = grid->neighbor_mask[cell];
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(mask & (1 << d))) continue;
+        int cost = p->g[cell + p->offsets[d]] + 1;
+        if (cost < best) best = cost;
+    }
+    return best;
+}
+
+static void update_vertex(Replanner* p, const Grid* grid, int cell) {
+    p->rhs[cell] = compute_rhs(p, grid, cell);
+    if (p->g[cell] != p->rhs[cell]) {
+        key_update(p, cell, calculate_key(p, grid, cell));
+    } else {
+        key_remove(p, cell);
+    }
+}
+
+static void update_neighbors(Replanner* p, const Grid* grid, int cell) {
+    unsigned char mask = grid->neighbor_mask[cell];
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (mask & (1 << d)) update_vertex(p, grid, cell + p->offsets[d]);
+    }
+}
+
+static void compute_shortest_path(Replanner* p, const Grid* grid, int start_cell) {
+    while (p->heap_size > 0) {
+        int cell = p->heap[0];
+        uint64_t old_key = p->key[cell];
+        if (old_key >= calculate_key(p, grid, start_cell) &&
+            p->rhs[start_cell] == p->g[start_cell]) {
+            break;
+        }
+
+        p->expansions++;
+        uint64_t new_key = calculate_key(p, grid, cell);
+        if (old_key < new_key) {
+            key_update(p, cell, new_key);
+        } else if (p->g[cell] > p->rhs[cell]) {
+            p->g[cell] = p->rhs[cell];
+            key_remove(p, cell);
+            update_neighbors(p, grid, cell);
+        } else {
+            p->g[cell] = DSTAR_INF;
+            update_vertex(p, grid, cell);
+            update_neighbors(p, grid, cell);
+        }
+    }
+}
+
+// ===== State Maintenance =====
+
+static void reset_search(Replanner* p, const Grid* grid) {
+    for (int i = 0; i < p->num_cells; i++) {
+        p->g[i] = DSTAR_INF;
+        p->rhs[i] = DSTAR_INF;
+        p->position[i] = -1;
+        p->goal[i] = 0;
+        p->walkable[i] = grid->cell_data[i] != CELL_OBSTACLE;
+    }
+    p->heap_size = 0;
+    p->km = 0;
+    p->targets = 0;
+    p->last_start = -1;
+    p->grid_version = grid->version;
+    p->initialized = 1;
+}
+
+static void cell_changed(Replanner* p, const Grid* grid, int cell) {
+    p->walkable[cell] = grid->cell_data[cell] != CELL_OBSTACLE;
+    update_vertex(p, grid, cell);
+    update_neighbors(p, grid, cell);
+}
+
+void replanner_notify_deltas(Replanner* planner, const Grid* grid,
+                             const CellDelta* deltas, int count) {
+    if (!planner->initialized || planner->num_cells != grid->total_cells) return;
+
+    for (int i = 0; i < count; i++) {
+        if (!is_valid_coordinate(grid, deltas[i].coord)) continue;
+        int cell = cell_index(grid, deltas[i].coord);
+        int now_walkable = grid->cell_data[cell] != CELL_OBSTACLE;
+        if (planner->walkable[cell] == now_walkable) continue;
+
+        cell_changed(planner, grid, cell);
+        planner->grid_version++;
+    }
+}
+
+// Changes nobody reported: compare the whole snapshot (O(cells))
+static void sync_unreported_changes(Replanner* p, const Grid* grid) {
+    for (int cell = 0; cell < p->num_cells; cell++) {
+        int now_walkable = grid->cell_data[cell] != CELL_OBSTACLE;
+        if (p->walkable[cell] != now_walkable) cell_changed(p, grid, cell);
+    }
+    p->grid_version = grid->version;
+}
+
+static void sync_targets(Replanner* p, const Grid* grid, uint64_t targets) {
+    uint64_t changed = p->targets ^ targets;
+    for (int s = 0; changed && s < grid->num_survivors; s++) {
+        if (!(changed & (1ULL << s))) continue;
+        changed &= ~(1ULL << s);
+
+        int cell = cell_index(grid, grid->survivors[s]);
+        p->goal[cell] = (targets >> s) & 1;
+        update_vertex(p, grid, cell);
+    }
+    p->targets = targets;
+}
+
+// ===== Public API =====
+
+Replanner* create_replanner(const Grid* grid) {
+    Replanner* planner = (Replanner*)safe_calloc(1, sizeof(Replanner));
+    int cells = grid->total_cells;
+
+    planner->num_cells = cells;
+    planner->g = (int*)safe_malloc(cells * sizeof(int));
+    planner->rhs = (int*)safe_malloc(cells * sizeof(int));
+    planner->walkable = (unsigned char*)safe_malloc(cells * sizeof(unsigned char));
+    planner->goal = (unsigned char*)safe_malloc(cells * sizeof(unsigned char));
+    planner->heap = (int*)safe_malloc(cells * sizeof(int));
+    planner->position = (int*)safe_malloc(cells * sizeof(int));
+    planner->key = (uint64_t*)safe_malloc(cells * sizeof(uint64_t));
+    get_neighbor_offsets(grid, planner->offsets);
+    return planner;
+}
+
+void free_replanner(Replanner* planner) {
+    if (!planner) return;
+    free(planner->g);
+    free(planner->rhs);
+    free(planner->walkable);
+    free(planner->goal);
+    free(planner->heap);
+    free(planner->position);
+    free(planner->key);
+    free(planner);
+}
+
+long long replanner_expansions(const Replanner* planner) {
+    return planner->expansions;
+}
+
+Path* replan_path(Replanner* planner, const Grid* grid, Coordinate position,
+                  uint64_t targets, int* survivor_found) {
+    if (survivor_found) *survivor_found = -1;
+    if (!is_valid_coordinate(grid, position)) return NULL;
+
+    if (planner->num_cells != grid->total_cells) {
+        error_exit("Replanner used with a grid of a different size");
+    }
+    if (grid->num_survivors < 64) targets &= (1ULL << grid->num_survivors) - 1;
+
+    int start_cell = cell_index(grid, position);
+    if (!planner->initialized) {
+        reset_search(planner, grid);
+    } else if (planner->grid_version != grid->version) {
+        sync_unreported_changes(planner, grid);
+    }
+
+    // Keys already queued were computed against the old robot cell; km
+    // keeps them comparable instead of re-keying the whole queue
+    if (planner->last_start >= 0 && planner->last_start != start_cell) {
+        planner->km += manhattan_distance(cell_coordinate(grid, planner->last_start),
+                                          position);
+    }
+    planner->last_start = start_cell;
+    planner->start = position;
+
+    sync_targets(planner, grid, targets);
+    if (!targets || !planner->walkable[start_cell]) return NULL;
+
+    compute_shortest_path(planner, grid, start_cell);
+
+    int steps = planner->g[start_cell];
+    if (steps >= DSTAR_INF) return NULL;
+
+    // Descend g from the robot: each step lowers the distance by one
+    Path* path = create_path(steps + 1);
+    int cell = start_cell;
+    path->coordinates[path->length++] = position;
+    while (!planner->goal[cell]) {
+        unsigned char mask = grid->neighbor_mask[cell];
+        int next = -1;
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(mask & (1 << d))) continue;
+            int candidate = cell + planner->offsets[d];
+            if (next < 0 || planner->g[candidate] < planner->g[next]) next = candidate;
+        }
+        if (next < 0 || planner->g[next] >= planner->g[cell] ||
+            path->length > steps) {
+            free_path(path);
+            return NULL;
+        }
+        cell = next;
+        add_coordinate_to_path(path, cell_coordinate(grid, cell));
+    }
+
+    if (survivor_found) *survivor_found = grid->survivor_map[cell];
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
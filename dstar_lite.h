@@ -0,0 +1,31 @@
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Incremental Replanning (D* Lite) =====
+// A backward search from every remaining survivor target toward the robot.
+// g[] holds each cell's distance to the nearest target and survives between
+// queries, so after the robot moves, a target is dropped or a few cells
+// change, only the affected part of the search is redone.
+//
+// Grid changes are picked up from replanner_notify_deltas() (pass the
+// deltas apply_obstacle_deltas() kept). Any change the planner was not told
+// about is found by comparing its walkability snapshot with the grid.
+
+typedef struct Replanner Replanner;
+
+Replanner* create_replanner(const Grid* grid);
+void free_replanner(Replanner* planner);
+void replanner_notify_deltas(Replanner* planner, const Grid* grid,
+                             const CellDelta* deltas, int count);
+
+// Shortest path from 'position' to the nearest survivor in 'targets'
+// (bit i = survivor i). NULL when none is reachable.
+Path* replan_path(Replanner* planner, const Grid* grid, Coordinate position,
+                  uint64_t targets, int* survivor_found);
+long long replanner_expansions(const Replanner* planner);
+
+#endif // DSTAR_LITE_H
@@ -2,42 +2,38 @@
 #include <float.h>
 
 // ===== Tournament Selection =====
-Path *tournament_selection(Path **population, int pop_size,
-                           int tournament_size) {
-    if (!population || pop_size <= 0)
-        return NULL;
+// Draws compare a fitness array copied once per generation instead of
+// following a Path pointer per sample
+static float *cache_fitness(Path **population, int pop_size, PathArena *arena) {
+    float *fitness = arena
+        ? (float *)path_arena_alloc(arena, pop_size * sizeof(float))
+        : (float *)safe_malloc(pop_size * sizeof(float));
+    for (int i = 0; i < pop_size; i++) {
+        fitness[i] = population[i]->fitness;
+    }
+    return fitness;
+}
 
+static int tournament_index(const float *fitness, int pop_size, int tournament_size) {
     if (tournament_size > pop_size) {
         tournament_size = pop_size;
     }
 
-    Path *best = NULL;
+    int best = -1;
     float best_fitness = -FLT_MAX;
 
     for (int i = 0; i < tournament_size; i++) {
         int idx = random_int(0, pop_size - 1);
 
-        if (population[idx]->fitness > best_fitness) {
-            best_fitness = population[idx]->fitness;
-            best = population[idx];
+        if (fitness[idx] > best_fitness) {
+            best_fitness = fitness[idx];
+            best = idx;
         }
     }
 
     return best;
 }
 
-Path **select_parents(Path **population, int pop_size, const Config *config,
-                      int num_parents) {
-    Path **parents = (Path **)safe_malloc(num_parents * sizeof(Path *));
-
-    for (int i = 0; i < num_parents; i++) {
-        parents[i] =
-            tournament_selection(population, pop_size, config->tournament_size);
-    }
-
-    return parents;
-}
-
 // ===== FIXED: Single Point Crossover with Connectivity =====
 Path *single_point_crossover(const Path *parent1, const Path *parent2,
                               const Grid *grid) {
@@ -66,7 +62,7 @@ Path *single_point_crossover(const Path *parent1, const Path *parent2,
 
         // If not adjacent, use A* to connect them
         if (!are_coordinates_adjacent(last_coord, next_coord)) {
-            Path *connector = connect_coordinates(grid, last_coord, next_coord);
+            Path *connector = connect_coordinates(grid, last_coord, next_coord, NULL);
             if (connector && connector->length > 1) {
                 // Add connecting path (skip first as it's already in child)
                 for (int i = 1; i < connector->length - 1; i++) {
@@ -116,7 +112,7 @@ Path *two_point_crossover(const Path *parent1, const Path *parent2,
         Coordinate next = parent2->coordinates[p2_start];
         
         if (!are_coordinates_adjacent(last, next)) {
-            Path *connector = connect_coordinates(grid, last, next);
+            Path *connector = connect_coordinates(grid, last, next, NULL);
             if (connector && connector->length > 1) {
                 for (int i = 1; i < connector->length - 1; i++) {
                     add_coordinate_to_path(child, connector->coordinates[i]);
@@ -137,7 +133,7 @@ Path *two_point_crossover(const Path *parent1, const Path *parent2,
         Coordinate next = parent1->coordinates[p1_end];
         
         if (!are_coordinates_adjacent(last, next)) {
-            Path *connector = connect_coordinates(grid, last, next);
+            Path *connector = connect_coordinates(grid, last, next, NULL);
             if (connector && connector->length > 1) {
                 for (int i = 1; i < connector->length - 1; i++) {
                     add_coordinate_to_path(child, connector->coordinates[i]);
@@ -200,20 +196,76 @@ Path *uniform_crossover(const Path *parent1, const Path *parent2,
     return child;
 }
 
-// ===== Crossover with two children =====
-Path **crossover_paths(const Path *parent1, const Path *parent2,
-                       const Grid *grid) {
-    Path **children = (Path **)safe_malloc(2 * sizeof(Path *));
+// ===== Mutation Workspace =====
+
+// Per-thread table over the grid cells (one per forked worker as well):
+// slot[cell] is only meaningful while stamp[cell] equals the current
+// generation, so indexing a new path is O(1) to start and O(n) to fill
+typedef struct {
+    int num_cells;
+    unsigned int generation;
+    unsigned int *stamp;
+    int *slot;
+} CellStamps;
+
+static _Thread_local CellStamps mutation_stamps = {0, 0, NULL, NULL};
+
+static CellStamps *begin_cell_stamps(const Grid *grid) {
+    CellStamps *stamps = &mutation_stamps;
+    if (stamps->num_cells != grid->total_cells) {
+        free(stamps->stamp);
+        free(stamps->slot);
+        stamps->num_cells = grid->total_cells;
+        stamps->stamp = (unsigned int *)safe_calloc(stamps->num_cells, sizeof(unsigned int));
+        stamps->slot = (int *)safe_malloc(stamps->num_cells * sizeof(int));
+        stamps->generation = 0;
+    }
+    stamps->generation++;
+    if (stamps->generation == 0) {
+        memset(stamps->stamp, 0, stamps->num_cells * sizeof(unsigned int));
+        stamps->generation = 1;
+    }
+    return stamps;
+}
 
-    children[0] = single_point_crossover(parent1, parent2, grid);
-    children[1] = single_point_crossover(parent2, parent1, grid);
+// Position of the cell in the indexed path, or -1
+static inline int stamped_slot(const CellStamps *stamps, int cell) {
+    return stamps->stamp[cell] == stamps->generation ? stamps->slot[cell] : -1;
+}
+
+static inline void stamp_cell(CellStamps *stamps, int cell, int slot) {
+    stamps->stamp[cell] = stamps->generation;
+    stamps->slot[cell] = slot;
+}
 
-    return children;
+// ===== Path Cell Index =====
+
+void index_path_cells(const Path *path, const Grid *grid) {
+    CellStamps *stamps = begin_cell_stamps(grid);
+    for (int i = 0; i < path->length; i++) {
+        if (is_valid_coordinate(grid, path->coordinates[i])) {
+            stamp_cell(stamps, cell_index(grid, path->coordinates[i]), i);
+        }
+    }
+}
+
+int indexed_path_position(const Grid *grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord) || mutation_stamps.num_cells != grid->total_cells) {
+        return -1;
+    }
+    return stamped_slot(&mutation_stamps, cell_index(grid, coord));
+}
+
+int indexed_path_contains(const Grid *grid, Coordinate coord) {
+    return indexed_path_position(grid, coord) >= 0;
 }
 
 // ===== Mutation: Insert Random Point =====
+// Inserts a neighbor of a random step in front of it; the buffer grows if
+// it is full. A path already MAX_PATH_LENGTH long is left alone: a longer
+// one would only be scored (and kept) up to that length.
 void mutate_insert_random(Path *path, const Grid *grid) {
-    if (!path || path->length < 2 || path->length >= MAX_PATH_LENGTH - 10) {
+    if (!path || path->length < 2 || path->length >= MAX_PATH_LENGTH) {
         return;
     }
 
@@ -228,13 +280,9 @@ void mutate_insert_random(Path *path, const Grid *grid) {
 
     Coordinate new_coord = neighbors[random_int(0, neighbor_count - 1)];
 
-    if (path->length >= path->capacity) {
-        return;
-    }
-
-    for (int i = path->length; i > insert_pos; i--) {
-        path->coordinates[i] = path->coordinates[i - 1];
-    }
+    reserve_path_capacity(path, path->length + 1);
+    memmove(&path->coordinates[insert_pos + 1], &path->coordinates[insert_pos],
+            (path->length - insert_pos) * sizeof(Coordinate));
 
     path->coordinates[insert_pos] = new_coord;
     path->length++;
@@ -245,6 +293,8 @@ void mutate_swap_segments(Path *path) {
     if (!path || path->length < 4)
         return;
 
+    make_path_writable(path);
+
     int pos1 = random_int(1, path->length - 2);
     int pos2 = random_int(pos1 + 1, path->length - 1);
 
@@ -254,24 +304,39 @@ void mutate_swap_segments(Path *path) {
 }
 
 // ===== Mutation: Remove Loop =====
-void mutate_remove_loop(Path *path) {
+// One pass over the path: when a step returns to a cell that is still in
+// the kept prefix, everything after that earlier visit is dropped. Every
+// loop (nested or overlapping ones too) goes in O(n), compacting in place.
+void mutate_remove_loop(Path *path, const Grid *grid) {
     if (!path || path->length < 3)
         return;
 
-    for (int i = 0; i < path->length - 2; i++) {
-        for (int j = i + 2; j < path->length; j++) {
-            if (coordinates_equal(path->coordinates[i], path->coordinates[j])) {
-                int loop_size = j - i;
+    make_path_writable(path);
 
-                for (int k = i + 1; k < path->length - loop_size; k++) {
-                    path->coordinates[k] = path->coordinates[k + loop_size];
-                }
+    CellStamps *stamps = begin_cell_stamps(grid);
+    int kept = 0;
 
-                path->length -= loop_size;
-                return;
-            }
+    for (int i = 0; i < path->length; i++) {
+        Coordinate coord = path->coordinates[i];
+        if (!is_valid_coordinate(grid, coord)) {
+            path->coordinates[kept++] = coord;
+            continue;
         }
+
+        int cell = cell_index(grid, coord);
+        int slot = stamped_slot(stamps, cell);
+
+        // A slot past the kept prefix, or one since overwritten, is stale
+        if (slot >= 0 && slot < kept && coordinates_equal(path->coordinates[slot], coord)) {
+            kept = slot + 1;
+            continue;
+        }
+
+        stamp_cell(stamps, cell, kept);
+        path->coordinates[kept++] = coord;
     }
+
+    path->length = kept;
 }
 
 // ===== Mutation: Reverse Segment =====
@@ -279,6 +344,8 @@ void mutate_reverse_segment(Path *path) {
     if (!path || path->length < 3)
         return;
 
+    make_path_writable(path);
+
     int start = random_int(0, path->length - 2);
     int end = random_int(start + 1, path->length - 1);
 
@@ -291,103 +358,115 @@ void mutate_reverse_segment(Path *path) {
     }
 }
 
-// ===== Main Mutation Function =====
-void mutate_path(Path *path, const Grid *grid, float mutation_rate) {
-    if (!path || !grid)
-        return;
-
-    if (random_float(0.0, 1.0) > mutation_rate) {
-        return;
-    }
-
-    int mutation_type = random_int(0, 3);
-
-    switch (mutation_type) {
-    case 0:
+// ===== Mutation Dispatch =====
+void apply_mutation(Path *path, const Grid *grid, int mutation) {
+    switch (mutation) {
+    case MUTATION_INSERT:
         mutate_insert_random(path, grid);
         break;
-    case 1:
+    case MUTATION_SWAP:
         mutate_swap_segments(path);
         break;
-    case 2:
-        mutate_remove_loop(path);
+    case MUTATION_REMOVE_LOOP:
+        mutate_remove_loop(path, grid);
         break;
-    case 3:
+    case MUTATION_REVERSE:
         mutate_reverse_segment(path);
         break;
     }
 }
 
 // ===== Elitism =====
-Path **apply_elitism(Path **population, int pop_size, int elitism_count) {
-    if (!population || elitism_count <= 0 || elitism_count > pop_size) {
-        return NULL;
-    }
-
-    Path **elite = (Path **)safe_malloc(elitism_count * sizeof(Path *));
-
-    for (int i = 0; i < elitism_count; i++) {
-        elite[i] = clone_path(population[i]);
-    }
-
-    return elite;
+int elite_count(int pop_size, const Config *config) {
+    int count = (pop_size * config->elitism_percent) / 100;
+    if (count < 1)
+        count = 1;
+    if (count > pop_size / 2)
+        count = pop_size / 2;
+    return count;
 }
 
 // ===== Create Next Generation =====
 Path **create_next_generation(Path **current_pop, int pop_size,
-                              const Grid *grid, const Config *config) {
+                              const Grid *grid, const Config *config,
+                              int generation, PathArena *arena) {
     if (!current_pop || !grid || !config || pop_size <= 0) {
         error_exit("Invalid parameters for create_next_generation");
     }
 
-    Path **next_gen = (Path **)safe_malloc(pop_size * sizeof(Path *));
+    PathArena *previous_arena = set_active_path_arena(arena);
+    Path **next_gen = arena
+        ? (Path **)path_arena_alloc(arena, pop_size * sizeof(Path *))
+        : (Path **)safe_malloc(pop_size * sizeof(Path *));
     int next_count = 0;
+    float *fitness = cache_fitness(current_pop, pop_size, arena);
 
-    int elitism_count = (pop_size * config->elitism_percent) / 100;
-    if (elitism_count < 1)
-        elitism_count = 1;
-    if (elitism_count > pop_size / 2)
-        elitism_count = pop_size / 2;
-
-    Path **elite = apply_elitism(current_pop, pop_size, elitism_count);
-
+    // Elites (current_pop[0..elitism_count) once ranked) go straight into
+    // the new generation, sharing their cells with the old one
+    int elitism_count = elite_count(pop_size, config);
     for (int i = 0; i < elitism_count; i++) {
-        next_gen[next_count++] = elite[i];
+        next_gen[next_count++] = share_path(current_pop[i]);
     }
-    free(elite);
+
+    // Operators are drawn from the adaptive mix; each child's operators and
+    // their cost are recorded for credit_operators(). Cost is counted in
+    // work, not time: search nodes expanded by repairs plus the child's
+    // cells, so a seeded run replays the same mix.
+    begin_operator_records(pop_size);
+    const SearchContext *search = default_search_context(grid);
 
     while (next_count < pop_size) {
-        Path *parent1 =
-            tournament_selection(current_pop, pop_size, config->tournament_size);
-        Path *parent2 =
-            tournament_selection(current_pop, pop_size, config->tournament_size);
+        seed_random(config->seed, rng_stream_id(RNG_DOMAIN_BREED, (uint32_t)generation,
+                                                (uint32_t)next_count));
+        int index1 = tournament_index(fitness, pop_size, config->tournament_size);
+        int index2 = tournament_index(fitness, pop_size, config->tournament_size);
+        Path *parent1 = current_pop[index1];
+        Path *parent2 = current_pop[index2];
 
         Path *child;
+        int crossover = OPERATOR_NONE;
+        int mutation = OPERATOR_NONE;
+        double crossover_cost = 0.0;
+        double mutation_cost = 0.0;
+        float parent_fitness = parent1->fitness;
 
         if (random_float(0.0, 1.0) < config->crossover_rate) {
-            int crossover_type = random_int(0, 2);
+            crossover = select_crossover_operator();
+            if (parent2->fitness > parent_fitness)
+                parent_fitness = parent2->fitness;
 
-            switch (crossover_type) {
-            case 0:
-                child = single_point_crossover(parent1, parent2, grid);
-                break;
-            case 1:
+            long long start = search->expansions;
+            switch (crossover) {
+            case CROSSOVER_TWO_POINT:
                 child = two_point_crossover(parent1, parent2, grid);
                 break;
-            case 2:
+            case CROSSOVER_UNIFORM:
                 child = uniform_crossover(parent1, parent2, grid);
                 break;
             default:
                 child = single_point_crossover(parent1, parent2, grid);
             }
+            crossover_cost = (double)(search->expansions - start + child->length);
         } else {
-            child = clone_path(parent1);
+            // Copied on write, so only children that mutate pay for a copy
+            child = share_path(parent1);
         }
 
-        mutate_path(child, grid, config->mutation_rate);
+        if (random_float(0.0, 1.0) <= config->mutation_rate) {
+            mutation = select_mutation_operator();
+            long long start = search->expansions;
+            apply_mutation(child, grid, mutation);
+            mutation_cost = (double)(search->expansions - start + child->length);
+        }
 
+        record_operators(next_count, crossover, crossover_cost,
+                         mutation, mutation_cost, parent_fitness);
         next_gen[next_count++] = child;
     }
 
+    if (!arena) {
+        free(fitness);
+    }
+    set_active_path_arena(previous_arena);
     return next_gen;
 }
@@ -2,18 +2,12 @@
 #define GENETIC_OPERATORS_H
 
 #include "grid_environment.h"
+#include "operator_selection.h"
+#include "path_arena.h"
 #include "path_generator.h"
 #include "utilities.h"
 
-// ===== Selection =====
-Path *tournament_selection(Path **population, int pop_size,
-                           int tournament_size);
-Path **select_parents(Path **population, int pop_size, const Config *config,
-                      int num_parents);
-
 // ===== Crossover with Validation =====
-Path **crossover_paths(const Path *parent1, const Path *parent2,
-                       const Grid *grid);
 Path *single_point_crossover(const Path *parent1, const Path *parent2,
                               const Grid *grid);
 Path *two_point_crossover(const Path *parent1, const Path *parent2,
@@ -21,18 +15,34 @@ Path *two_point_crossover(const Path *parent1, const Path *parent2,
 Path *uniform_crossover(const Path *parent1, const Path *parent2,
                         const Grid *grid);
 
+// ===== Path Cell Index =====
+// A per-thread stamp table over the grid cells, shared with loop removal.
+// index_path_cells() is O(n) and drops the previous index in O(1); lookups
+// are then O(1) until the next index or mutation on the same thread.
+void index_path_cells(const Path *path, const Grid *grid);
+int indexed_path_contains(const Grid *grid, Coordinate coord);
+int indexed_path_position(const Grid *grid, Coordinate coord); // Last visit, -1 = none
+
 // ===== Mutation =====
-void mutate_path(Path *path, const Grid *grid, float mutation_rate);
+// Insertion stops at MAX_PATH_LENGTH: later cells are never scored.
+void apply_mutation(Path *path, const Grid *grid, int mutation); // MutationOperator
 void mutate_insert_random(Path *path, const Grid *grid);
 void mutate_swap_segments(Path *path);
-void mutate_remove_loop(Path *path);
+void mutate_remove_loop(Path *path, const Grid *grid);
 void mutate_reverse_segment(Path *path);
 
 // ===== Elitism =====
-Path **apply_elitism(Path **population, int pop_size, int elitism_count);
+// Elites are the first elite_count() paths of a population ranked with
+// select_best_paths()
+int elite_count(int pop_size, const Config *config);
 
 // ===== Population Management =====
+// With an arena, the children, their temporaries and the returned array all
+// come from it (the caller resets it instead of freeing); NULL uses the heap.
+// Child i of 'generation' draws from its own random stream. Crossover and
+// mutation operators come from operator_selection.h.
 Path **create_next_generation(Path **current_pop, int pop_size,
-                              const Grid *grid, const Config *config);
+                              const Grid *grid, const Config *config,
+                              int generation, PathArena *arena);
 
 #endif // GENETIC_OPERATORS_H
@@ -1,377 +1,631 @@
-#include "grid_environment.h"
-
-// ===== Grid Creation and Destruction =====
-
-// Create a new 3D grid
-Grid* create_grid(int size_x, int size_y, int size_z) {
-    if (size_x <= 0 || size_y <= 0 || size_z <= 0) {
-        error_exit("Invalid grid dimensions");
-    }
-    
-    Grid* grid = (Grid*)safe_malloc(sizeof(Grid));
-    grid->size_x = size_x;
-    grid->size_y = size_y;
-    grid->size_z = size_z;
-    grid->total_cells = size_x * size_y * size_z;
-    grid->obstacle_count = 0;
-    grid->num_survivors = 0;
-    grid->survivors = NULL;
-    
-    // Allocate 3D array
-    grid->cells = (CellType***)safe_malloc(size_x * sizeof(CellType**));
-    for (int x = 0; x < size_x; x++) {
-        grid->cells[x] = (CellType**)safe_malloc(size_y * sizeof(CellType*));
-        for (int y = 0; y < size_y; y++) {
-            grid->cells[x][y] = (CellType*)safe_calloc(size_z, sizeof(CellType));
-        }
-    }
-    
-    return grid;
-}
-
-// Free grid memory
-void free_grid(Grid* grid) {
-    if (!grid) return;
-    
-    // Free 3D array
-    for (int x = 0; x < grid->size_x; x++) {
-        for (int y = 0; y < grid->size_y; y++) {
-            free(grid->cells[x][y]);
-        }
-        free(grid->cells[x]);
-    }
-    free(grid->cells);
-    
-    // Free survivors array
-    if (grid->survivors) {
-        free(grid->survivors);
-    }
-    
-    free(grid);
-}
-
-// ===== Grid Initialization =====
-
-// Initialize grid with configuration
-void initialize_grid(Grid* grid, const Config* config) {
-    if (!grid || !config) {
-        error_exit("Invalid grid or config");
-    }
-    
-    // Clear all cells
-    for (int x = 0; x < grid->size_x; x++) {
-        for (int y = 0; y < grid->size_y; y++) {
-            for (int z = 0; z < grid->size_z; z++) {
-                grid->cells[x][y][z] = CELL_EMPTY;
-            }
-        }
-    }
-    
-    // Set start position
-    set_start_position(grid, config->start_pos);
-    
-    // Place obstacles
-    place_obstacles(grid, config->obstacle_percent);
-    
-    // Place survivors
-    place_survivors(grid, config->num_survivors);
-    
-    if (config->verbose) {
-        print_grid_info(grid);
-    }
-}
-
-// Place obstacles randomly in the grid
-void place_obstacles(Grid* grid, int obstacle_percent) {
-    if (obstacle_percent < 0 || obstacle_percent > 100) {
-        warning("Invalid obstacle percentage, using 25%");
-        obstacle_percent = 25;
-    }
-    
-    int target_obstacles = (grid->total_cells * obstacle_percent) / 100;
-    int placed = 0;
-    
-    while (placed < target_obstacles) {
-        int x = random_int(0, grid->size_x - 1);
-        int y = random_int(0, grid->size_y - 1);
-        int z = random_int(0, grid->size_z - 1);
-        
-        Coordinate coord = create_coordinate(x, y, z);
-        
-        // Don't place obstacle at start position
-        if (coordinates_equal(coord, grid->start)) {
-            continue;
-        }
-        
-        // Check if cell is already occupied
-        if (grid->cells[x][y][z] == CELL_EMPTY) {
-            grid->cells[x][y][z] = CELL_OBSTACLE;
-            placed++;
-        }
-    }
-    
-    grid->obstacle_count = placed;
-}
-
-// Place survivors randomly in the grid
-void place_survivors(Grid* grid, int num_survivors) {
-    if (num_survivors <= 0 || num_survivors > MAX_SURVIVORS) {
-        warning("Invalid number of survivors");
-        return;
-    }
-    
-    // Allocate survivors array
-    grid->survivors = (Coordinate*)safe_malloc(num_survivors * sizeof(Coordinate));
-    grid->num_survivors = 0;
-    
-    int attempts = 0;
-    int max_attempts = grid->total_cells * 2;
-    
-    while (grid->num_survivors < num_survivors && attempts < max_attempts) {
-        int x = random_int(0, grid->size_x - 1);
-        int y = random_int(0, grid->size_y - 1);
-        int z = random_int(0, grid->size_z - 1);
-        
-        Coordinate coord = create_coordinate(x, y, z);
-        
-        // Check if position is valid (not start, not obstacle, not already survivor)
-        if (!coordinates_equal(coord, grid->start) && 
-            grid->cells[x][y][z] == CELL_EMPTY) {
-            
-            grid->cells[x][y][z] = CELL_SURVIVOR;
-            grid->survivors[grid->num_survivors] = coord;
-            grid->num_survivors++;
-        }
-        
-        attempts++;
-    }
-    
-    if (grid->num_survivors < num_survivors) {
-        warning("Could not place all survivors due to grid constraints");
-    }
-}
-
-// Set the starting position
-void set_start_position(Grid* grid, Coordinate start) {
-    if (!is_valid_coordinate(grid, start)) {
-        warning("Invalid start position, using (0,0,0)");
-        start = create_coordinate(0, 0, 0);
-    }
-    
-    grid->start = start;
-    grid->cells[start.x][start.y][start.z] = CELL_START;
-}
-
-// ===== Grid Queries =====
-
-// Get cell type at coordinate
-CellType get_cell(const Grid* grid, Coordinate coord) {
-    if (!is_valid_coordinate(grid, coord)) {
-        return CELL_OBSTACLE; // Treat out of bounds as obstacle
-    }
-    return grid->cells[coord.x][coord.y][coord.z];
-}
-
-// Set cell type at coordinate
-void set_cell(Grid* grid, Coordinate coord, CellType type) {
-    if (is_valid_coordinate(grid, coord)) {
-        grid->cells[coord.x][coord.y][coord.z] = type;
-    }
-}
-
-// Check if coordinate is within grid bounds
-int is_valid_coordinate(const Grid* grid, Coordinate coord) {
-    return (coord.x >= 0 && coord.x < grid->size_x &&
-            coord.y >= 0 && coord.y < grid->size_y &&
-            coord.z >= 0 && coord.z < grid->size_z);
-}
-
-// Check if coordinate is walkable (not obstacle)
-int is_walkable(const Grid* grid, Coordinate coord) {
-    if (!is_valid_coordinate(grid, coord)) {
-        return 0;
-    }
-    CellType type = get_cell(grid, coord);
-    return (type != CELL_OBSTACLE);
-}
-
-// Check if coordinate contains obstacle
-int is_obstacle(const Grid* grid, Coordinate coord) {
-    return (get_cell(grid, coord) == CELL_OBSTACLE);
-}
-
-// Check if coordinate contains survivor
-int is_survivor(const Grid* grid, Coordinate coord) {
-    return (get_cell(grid, coord) == CELL_SURVIVOR);
-}
-
-// ===== Survivor Management =====
-
-// Get survivor index at coordinate (-1 if none)
-int get_survivor_at(const Grid* grid, Coordinate coord) {
-    for (int i = 0; i < grid->num_survivors; i++) {
-        if (coordinates_equal(grid->survivors[i], coord)) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// Get survivor position by index
-Coordinate get_survivor_position(const Grid* grid, int index) {
-    if (index >= 0 && index < grid->num_survivors) {
-        return grid->survivors[index];
-    }
-    return create_coordinate(-1, -1, -1);
-}
-
-// Count survivors in radius around center
-int count_survivors_in_area(const Grid* grid, Coordinate center, int radius) {
-    int count = 0;
-    for (int i = 0; i < grid->num_survivors; i++) {
-        if (manhattan_distance(center, grid->survivors[i]) <= radius) {
-            count++;
-        }
-    }
-    return count;
-}
-
-// ===== Neighbor Functions =====
-
-// Get all neighbors (6-connected in 3D: up, down, left, right, forward, back)
-int get_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors) {
-    int count = 0;
-    
-    // Define 6 directions in 3D
-    int dx[] = {1, -1, 0, 0, 0, 0};
-    int dy[] = {0, 0, 1, -1, 0, 0};
-    int dz[] = {0, 0, 0, 0, 1, -1};
-    
-    for (int i = 0; i < 6; i++) {
-        Coordinate neighbor = create_coordinate(
-            coord.x + dx[i],
-            coord.y + dy[i],
-            coord.z + dz[i]
-        );
-        
-        if (is_valid_coordinate(grid, neighbor)) {
-            neighbors[count++] = neighbor;
-        }
-    }
-    
-    return count;
-}
-
-// Get only walkable neighbors
-int get_walkable_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors) {
-    Coordinate all_neighbors[6];
-    int total = get_neighbors(grid, coord, all_neighbors);
-    int count = 0;
-    
-    for (int i = 0; i < total; i++) {
-        if (is_walkable(grid, all_neighbors[i])) {
-            neighbors[count++] = all_neighbors[i];
-        }
-    }
-    
-    return count;
-}
-
-// ===== Grid Visualization =====
-
-// Print a single layer of the grid
-void print_grid_layer(const Grid* grid, int z) {
-    if (z < 0 || z >= grid->size_z) {
-        printf("Invalid layer: %d\n", z);
-        return;
-    }
-    
-    printf("\n=== Grid Layer Z=%d ===\n", z);
-    for (int y = 0; y < grid->size_y; y++) {
-        for (int x = 0; x < grid->size_x; x++) {
-            CellType type = grid->cells[x][y][z];
-            switch (type) {
-                case CELL_EMPTY:    printf(". "); break;
-                case CELL_OBSTACLE: printf("# "); break;
-                case CELL_SURVIVOR: printf("S "); break;
-                case CELL_START:    printf("R "); break;
-            }
-        }
-        printf("\n");
-    }
-    printf("Legend: . = Empty, # = Obstacle, S = Survivor, R = Robot Start\n");
-}
-
-// Print grid information
-void print_grid_info(const Grid* grid) {
-    printf("\n========== Grid Information ==========\n");
-    printf("Dimensions: %dx%dx%d\n", grid->size_x, grid->size_y, grid->size_z);
-    printf("Total Cells: %d\n", grid->total_cells);
-    printf("Obstacles: %d (%.1f%%)\n", 
-           grid->obstacle_count, 
-           (float)grid->obstacle_count / grid->total_cells * 100);
-    printf("Survivors: %d\n", grid->num_survivors);
-    printf("Start Position: (%d, %d, %d)\n", 
-           grid->start.x, grid->start.y, grid->start.z);
-    printf("======================================\n");
-}
-
-// Save grid to file
-void save_grid_to_file(const Grid* grid, const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        warning("Could not save grid to file");
-        return;
-    }
-    
-    fprintf(file, "Grid Dimensions: %dx%dx%d\n", 
-            grid->size_x, grid->size_y, grid->size_z);
-    fprintf(file, "Survivors: %d\n", grid->num_survivors);
-    fprintf(file, "Obstacles: %d\n\n", grid->obstacle_count);
-    
-    for (int z = 0; z < grid->size_z; z++) {
-        fprintf(file, "Layer Z=%d:\n", z);
-        for (int y = 0; y < grid->size_y; y++) {
-            for (int x = 0; x < grid->size_x; x++) {
-                CellType type = grid->cells[x][y][z];
-                switch (type) {
-                    case CELL_EMPTY:    fprintf(file, ". "); break;
-                    case CELL_OBSTACLE: fprintf(file, "# "); break;
-                    case CELL_SURVIVOR: fprintf(file, "S "); break;
-                    case CELL_START:    fprintf(file, "R "); break;
-                }
-            }
-            fprintf(file, "\n");
-        }
-        fprintf(file, "\n");
-    }
-    
-    fclose(file);
-}
-
-// ===== Grid Statistics =====
-
-// Count total obstacles
-int count_obstacles(const Grid* grid) {
-    return grid->obstacle_count;
-}
-
-// Count empty cells
-int count_empty_cells(const Grid* grid) {
-    int count = 0;
-    for (int x = 0; x < grid->size_x; x++) {
-        for (int y = 0; y < grid->size_y; y++) {
-            for (int z = 0; z < grid->size_z; z++) {
-                if (grid->cells[x][y][z] == CELL_EMPTY) {
-                    count++;
-                }
-            }
-        }
-    }
-    return count;
-}
-
-// Calculate obstacle density
-float calculate_obstacle_density(const Grid* grid) {
-    return (float)grid->obstacle_count / grid->total_cells;
+#include "grid_environment.h"
+#include "scenario_generator.h"
+#include "distance_tables.h"
+#include "path_hierarchy.h"
+#include "landmarks.h"
+#include "connector_cache.h"
+
+// 6-connected direction offsets (+x, -x, +y, -y, +z, -z)
+const int DIR_DX[NUM_DIRECTIONS] = {1, -1, 0, 0, 0, 0};
+const int DIR_DY[NUM_DIRECTIONS] = {0, 0, 1, -1, 0, 0};
+const int DIR_DZ[NUM_DIRECTIONS] = {0, 0, 0, 0, 1, -1};
+
+// ===== Grid Creation and Destruction =====
+
+// Create a new 3D grid
+Grid* create_grid(int size_x, int size_y, int size_z) {
+    if (size_x <= 0 || size_y <= 0 || size_z <= 0) {
+        error_exit("Invalid grid dimensions");
+    }
+    
+    Grid* grid = (Grid*)safe_malloc(sizeof(Grid));
+    grid->size_x = size_x;
+    grid->size_y = size_y;
+    grid->size_z = size_z;
+    grid->total_cells = size_x * size_y * size_z;
+    grid->obstacle_count = 0;
+    grid->num_survivors = 0;
+    grid->survivors = NULL;
+    grid->version = 0;
+    
+    // Allocate flat cell storage and 3D views into it
+    grid->cell_data = (CellType*)safe_calloc(grid->total_cells, sizeof(CellType));
+    grid->cells = (CellType***)safe_malloc(size_x * sizeof(CellType**));
+    for (int x = 0; x < size_x; x++) {
+        grid->cells[x] = (CellType**)safe_malloc(size_y * sizeof(CellType*));
+        for (int y = 0; y < size_y; y++) {
+            grid->cells[x][y] = grid->cell_data + (x * size_y + y) * size_z;
+        }
+    }
+    
+    // Auxiliary tables
+    grid->survivor_map = (signed char*)safe_malloc(grid->total_cells * sizeof(signed char));
+    memset(grid->survivor_map, -1, grid->total_cells * sizeof(signed char));
+    grid->neighbor_mask = (unsigned char*)safe_calloc(grid->total_cells, sizeof(unsigned char));
+    grid->component = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    grid->num_components = 0;
+    grid->reachable_survivors = 0;
+    grid->distances = NULL;
+    grid->hierarchy = NULL;
+    grid->landmarks = NULL;
+    
+    return grid;
+}
+
+// Free grid memory
+void free_grid(Grid* grid) {
+    if (!grid) return;
+    
+    // Free 3D views and flat storage
+    for (int x = 0; x < grid->size_x; x++) {
+        free(grid->cells[x]);
+    }
+    free(grid->cells);
+    free(grid->cell_data);
+    
+    free(grid->survivor_map);
+    free(grid->neighbor_mask);
+    free(grid->component);
+    free_distance_table(grid->distances);
+    free_path_hierarchy(grid->hierarchy);
+    free_landmark_table(grid->landmarks);
+    
+    // Free survivors array
+    if (grid->survivors) {
+        free(grid->survivors);
+    }
+    
+    free(grid);
+}
+
+// ===== Grid Initialization =====
+
+// Initialize grid with configuration (seeded, reproducible scenario)
+void initialize_grid(Grid* grid, const Config* config) {
+    if (!grid || !config) {
+        error_exit("Invalid grid or config");
+    }
+    
+    ScenarioOptions options = scenario_options_from_config(config);
+    printf("Scenario: %s, seed %llu (set SCENARIO_SEED to reproduce)\n",
+           scenario_type_name(options.type), (unsigned long long)options.seed);
+    
+    generate_scenario(grid, &options);
+    
+    if (config->verbose) {
+        print_grid_info(grid);
+    }
+}
+
+// Place obstacles randomly in the grid (shuffle-based, no rejection loop)
+void place_obstacles(Grid* grid, int obstacle_percent) {
+    if (obstacle_percent < 0 || obstacle_percent > 100) {
+        warning("Invalid obstacle percentage, using 25%");
+        obstacle_percent = 25;
+    }
+    
+    int target_obstacles = (grid->total_cells * obstacle_percent) / 100;
+    
+    Rng rng;
+    rng_seed(&rng, rng_next(random_stream()));
+    grid->obstacle_count = 0;
+    scatter_obstacles(grid, &rng, target_obstacles);
+}
+
+// Place survivors randomly in the grid
+void place_survivors(Grid* grid, int num_survivors) {
+    if (num_survivors <= 0 || num_survivors > MAX_SURVIVORS) {
+        warning("Invalid number of survivors");
+        return;
+    }
+    
+    Rng rng;
+    rng_seed(&rng, rng_next(random_stream()));
+    scatter_survivors(grid, &rng, num_survivors);
+}
+
+// ===== Auxiliary Tables =====
+
+// Compute the walkable-neighbor bitmask of a single cell
+unsigned char compute_neighbor_mask(const Grid* grid, int index) {
+    Coordinate c = cell_coordinate(grid, index);
+    unsigned char mask = 0;
+    
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        Coordinate n = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+        if (is_valid_coordinate(grid, n) &&
+            grid->cell_data[cell_index(grid, n)] != CELL_OBSTACLE) {
+            mask |= (unsigned char)(1 << d);
+        }
+    }
+    return mask;
+}
+
+// Rebuild survivor lookup and neighbor masks from the current cell layout
+void build_grid_tables(Grid* grid) {
+    memset(grid->survivor_map, -1, grid->total_cells * sizeof(signed char));
+    for (int i = 0; i < grid->num_survivors; i++) {
+        grid->survivor_map[cell_index(grid, grid->survivors[i])] = (signed char)i;
+    }
+    
+    for (int i = 0; i < grid->total_cells; i++) {
+        grid->neighbor_mask[i] = compute_neighbor_mask(grid, i);
+    }
+    
+    label_components(grid);
+    grid->version++;
+}
+
+// ===== Reachability =====
+
+// Offset of the neighbor in direction d from a cell index
+static int neighbor_offset(const Grid* grid, int d) {
+    switch (d) {
+        case DIR_POS_X: return grid->size_y * grid->size_z;
+        case DIR_NEG_X: return -grid->size_y * grid->size_z;
+        case DIR_POS_Y: return grid->size_z;
+        case DIR_NEG_Y: return -grid->size_z;
+        case DIR_POS_Z: return 1;
+        default:        return -1;
+    }
+}
+
+// Cell-index offsets of the six neighbors (valid where the mask bit is set)
+void get_neighbor_offsets(const Grid* grid, int* offsets) {
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        offsets[d] = neighbor_offset(grid, d);
+    }
+}
+
+// Flood-fill one component from a seed cell using the neighbor masks
+static void flood_component(Grid* grid, int seed, int label, int* queue) {
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    
+    int head = 0, tail = 0;
+    grid->component[seed] = label;
+    queue[tail++] = seed;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        unsigned char mask = grid->neighbor_mask[current];
+        
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(mask & (1 << d))) continue;
+            int next = current + offsets[d];
+            if (grid->component[next] != label) {
+                grid->component[next] = label;
+                queue[tail++] = next;
+            }
+        }
+    }
+}
+
+static void count_reachable_survivors(Grid* grid) {
+    grid->reachable_survivors = 0;
+    for (int i = 0; i < grid->num_survivors; i++) {
+        if (is_survivor_reachable(grid, i)) {
+            grid->reachable_survivors++;
+        }
+    }
+}
+
+// Label walkable connected components (6-connected) in one linear pass
+void label_components(Grid* grid) {
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    
+    for (int i = 0; i < grid->total_cells; i++) {
+        grid->component[i] = -1;
+    }
+    
+    grid->num_components = 0;
+    for (int i = 0; i < grid->total_cells; i++) {
+        if (grid->component[i] < 0 && grid->cell_data[i] != CELL_OBSTACLE) {
+            flood_component(grid, i, grid->num_components++, queue);
+        }
+    }
+    
+    free(queue);
+    count_reachable_survivors(grid);
+}
+
+// Component of a cell (-1 for obstacles and out-of-bounds)
+int get_component(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) return -1;
+    return grid->component[cell_index(grid, coord)];
+}
+
+// Collect the components a cell can walk into: its own, or for an
+// obstacle cell (paths may stand on debris) those of its walkable neighbors
+static int cell_exit_components(const Grid* grid, Coordinate coord, int* labels) {
+    int own = get_component(grid, coord);
+    if (own >= 0) {
+        labels[0] = own;
+        return 1;
+    }
+    if (!is_valid_coordinate(grid, coord)) return 0;
+    
+    Coordinate neighbors[NUM_DIRECTIONS];
+    int n = get_walkable_neighbors(grid, coord, neighbors);
+    for (int i = 0; i < n; i++) {
+        labels[i] = get_component(grid, neighbors[i]);
+    }
+    return n;
+}
+
+// O(1) check whether a walkable route between two cells can exist
+int cells_connected(const Grid* grid, Coordinate a, Coordinate b) {
+    int labels_a[NUM_DIRECTIONS], labels_b[NUM_DIRECTIONS];
+    int count_a = cell_exit_components(grid, a, labels_a);
+    int count_b = cell_exit_components(grid, b, labels_b);
+    
+    for (int i = 0; i < count_a; i++) {
+        for (int j = 0; j < count_b; j++) {
+            if (labels_a[i] == labels_b[j]) return 1;
+        }
+    }
+    return 0;
+}
+
+// Check whether a survivor shares the start cell's component
+int is_survivor_reachable(const Grid* grid, int survivor_index) {
+    if (survivor_index < 0 || survivor_index >= grid->num_survivors) return 0;
+    return cells_connected(grid, grid->start, grid->survivors[survivor_index]);
+}
+
+// Set the starting position
+void set_start_position(Grid* grid, Coordinate start) {
+    if (!is_valid_coordinate(grid, start)) {
+        warning("Invalid start position, using (0,0,0)");
+        start = create_coordinate(0, 0, 0);
+    }
+    
+    grid->start = start;
+    grid->cells[start.x][start.y][start.z] = CELL_START;
+}
+
+// ===== Grid Queries =====
+
+// Get cell type at coordinate
+CellType get_cell(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) {
+        return CELL_OBSTACLE; // Treat out of bounds as obstacle
+    }
+    return grid->cells[coord.x][coord.y][coord.z];
+}
+
+// Set cell type at coordinate, keeping the neighbor masks and
+// obstacle count in step when walkability changes
+void set_cell(Grid* grid, Coordinate coord, CellType type) {
+    if (!is_valid_coordinate(grid, coord)) {
+        return;
+    }
+    
+    int index = cell_index(grid, coord);
+    CellType old_type = grid->cell_data[index];
+    grid->cell_data[index] = type;
+    
+    int was_walkable = (old_type != CELL_OBSTACLE);
+    int now_walkable = (type != CELL_OBSTACLE);
+    if (was_walkable == now_walkable) {
+        return;
+    }
+    
+    grid->obstacle_count += now_walkable ? -1 : 1;
+    grid->version++;
+    
+    // Only the six neighbors' bits pointing back at this cell change
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        Coordinate n = create_coordinate(coord.x + DIR_DX[d], coord.y + DIR_DY[d],
+                                         coord.z + DIR_DZ[d]);
+        if (!is_valid_coordinate(grid, n)) continue;
+        
+        unsigned char back_bit = (unsigned char)(1 << (d ^ 1));
+        int n_index = cell_index(grid, n);
+        if (now_walkable) {
+            grid->neighbor_mask[n_index] |= back_bit;
+        } else {
+            grid->neighbor_mask[n_index] &= (unsigned char)~back_bit;
+        }
+    }
+}
+
+// Check if coordinate is within grid bounds
+int is_valid_coordinate(const Grid* grid, Coordinate coord) {
+    return (coord.x >= 0 && coord.x < grid->size_x &&
+            coord.y >= 0 && coord.y < grid->size_y &&
+            coord.z >= 0 && coord.z < grid->size_z);
+}
+
+// Check if coordinate is walkable (not obstacle)
+int is_walkable(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) {
+        return 0;
+    }
+    CellType type = get_cell(grid, coord);
+    return (type != CELL_OBSTACLE);
+}
+
+// Check if coordinate contains obstacle
+int is_obstacle(const Grid* grid, Coordinate coord) {
+    return (get_cell(grid, coord) == CELL_OBSTACLE);
+}
+
+// Check if coordinate contains survivor
+int is_survivor(const Grid* grid, Coordinate coord) {
+    return (get_cell(grid, coord) == CELL_SURVIVOR);
+}
+
+// ===== Dynamic Updates =====
+
+// Update the component labels for one changed cell when that is possible
+// locally. Returns 0 when the change may split or merge components.
+static int update_component_for_change(Grid* grid, Coordinate coord) {
+    int index = cell_index(grid, coord);
+    unsigned char mask = grid->neighbor_mask[index];
+    int label = -1;
+    int walkable_neighbors = 0;
+    
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(mask & (1 << d))) continue;
+        int neighbor_label = grid->component[index + neighbor_offset(grid, d)];
+        if (label >= 0 && neighbor_label != label) {
+            return 0;
+        }
+        label = neighbor_label;
+        walkable_neighbors++;
+    }
+    
+    if (grid->cell_data[index] == CELL_OBSTACLE) {
+        // Removing a dead-end cell cannot disconnect anything
+        grid->component[index] = -1;
+        return walkable_neighbors <= 1;
+    }
+    
+    // Cleared cell joins its neighbors' single component (or a new one)
+    grid->component[index] = (label >= 0) ? label : grid->num_components++;
+    return 1;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// True when some cell changes more than once in the batch
+static int has_repeated_cells(const Grid* grid, const CellDelta* deltas, int count) {
+    int* cells = (int*)safe_malloc((count > 0 ? count : 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        cells[i] = cell_index(grid, deltas[i].coord);
+    }
+    qsort(cells, count, sizeof(int), compare_ints);
+
+    int repeated = 0;
+    for (int i = 1; i < count && !repeated; i++) {
+        repeated = cells[i] == cells[i - 1];
+    }
+    free(cells);
+    return repeated;
+}
+
+// Apply a batch of collapse/clearance events. Survivor and start cells are
+// never blocked. The array is compacted in place to the deltas that actually
+// changed the layout; the number kept is returned.
+//
+// Cached search tables are patched for the whole batch at once. The
+// patches assume each cell flips once, so a batch that flips a cell back
+// leaves them to the lazy full rebuild in their get_* functions.
+int apply_obstacle_deltas(Grid* grid, CellDelta* deltas, int count) {
+    int kept = 0;
+    int relabel = 0;
+    int base_version = grid->version;
+    
+    for (int i = 0; i < count; i++) {
+        Coordinate coord = deltas[i].coord;
+        if (!is_valid_coordinate(grid, coord)) {
+            continue;
+        }
+        
+        CellType current = get_cell(grid, coord);
+        if (current == CELL_SURVIVOR || current == CELL_START) {
+            continue;
+        }
+        
+        CellType target = deltas[i].blocked ? CELL_OBSTACLE : CELL_EMPTY;
+        if (current == target) {
+            continue;
+        }
+        
+        set_cell(grid, coord, target);
+        deltas[kept++] = deltas[i];
+        
+        if (!relabel) {
+            relabel = !update_component_for_change(grid, coord);
+        }
+    }
+    
+    // Splits and merges need a fresh labeling, done once per batch
+    if (relabel) {
+        label_components(grid);
+    } else if (kept > 0) {
+        count_reachable_survivors(grid);
+    }
+    
+    if (kept > 0 && !has_repeated_cells(grid, deltas, kept)) {
+        update_distance_table(grid, deltas, kept, base_version);
+        update_landmark_table(grid, deltas, kept, base_version);
+        update_path_hierarchy(grid, deltas, kept, base_version);
+    }
+    // Judges each cell by its final state, so repeats are fine
+    update_connector_cache(grid, deltas, kept, base_version);
+    
+    return kept;
+}
+
+// ===== Survivor Management =====
+
+// Get survivor index at coordinate (-1 if none)
+int get_survivor_at(const Grid* grid, Coordinate coord) {
+    if (!is_valid_coordinate(grid, coord)) {
+        return -1;
+    }
+    return grid->survivor_map[cell_index(grid, coord)];
+}
+
+// Get survivor position by index
+Coordinate get_survivor_position(const Grid* grid, int index) {
+    if (index >= 0 && index < grid->num_survivors) {
+        return grid->survivors[index];
+    }
+    return create_coordinate(-1, -1, -1);
+}
+
+// Count survivors in radius around center
+int count_survivors_in_area(const Grid* grid, Coordinate center, int radius) {
+    int count = 0;
+    for (int i = 0; i < grid->num_survivors; i++) {
+        if (manhattan_distance(center, grid->survivors[i]) <= radius) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// ===== Neighbor Functions =====
+
+// Get all neighbors (6-connected in 3D: up, down, left, right, forward, back)
+int get_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors) {
+    int count = 0;
+    
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        Coordinate neighbor = create_coordinate(
+            coord.x + DIR_DX[i],
+            coord.y + DIR_DY[i],
+            coord.z + DIR_DZ[i]
+        );
+        
+        if (is_valid_coordinate(grid, neighbor)) {
+            neighbors[count++] = neighbor;
+        }
+    }
+    
+    return count;
+}
+
+// Get only walkable neighbors (read from the precomputed neighbor mask)
+int get_walkable_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors) {
+    if (!is_valid_coordinate(grid, coord)) {
+        return 0;
+    }
+    
+    unsigned char mask = grid->neighbor_mask[cell_index(grid, coord)];
+    int count = 0;
+    
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (mask & (1 << d)) {
+            neighbors[count++] = create_coordinate(coord.x + DIR_DX[d],
+                                                   coord.y + DIR_DY[d],
+                                                   coord.z + DIR_DZ[d]);
+        }
+    }
+    
+    return count;
+}
+
+// ===== Grid Visualization =====
+
+// Print a single layer of the grid
+void print_grid_layer(const Grid* grid, int z) {
+    if (z < 0 || z >= grid->size_z) {
+        printf("Invalid layer: %d\n", z);
+        return;
+    }
+    
+    printf("\n=== Grid Layer Z=%d ===\n", z);
+    for (int y = 0; y < grid->size_y; y++) {
+        for (int x = 0; x < grid->size_x; x++) {
+            CellType type = grid->cells[x][y][z];
+            switch (type) {
+                case CELL_EMPTY:    printf(". "); break;
+                case CELL_OBSTACLE: printf("# "); break;
+                case CELL_SURVIVOR: printf("S "); break;
+                case CELL_START:    printf("R "); break;
+            }
+        }
+        printf("\n");
+    }
+    printf("Legend: . = Empty, # = Obstacle, S = Survivor, R = Robot Start\n");
+}
+
+// Print grid information
+void print_grid_info(const Grid* grid) {
+    printf("\n========== Grid Information ==========\n");
+    printf("Dimensions: %dx%dx%d\n", grid->size_x, grid->size_y, grid->size_z);
+    printf("Total Cells: %d\n", grid->total_cells);
+    printf("Obstacles: %d (%.1f%%)\n", 
+           grid->obstacle_count, 
+           (float)grid->obstacle_count / grid->total_cells * 100);
+    printf("Survivors: %d (%d reachable from start)\n",
+           grid->num_survivors, grid->reachable_survivors);
+    printf("Walkable Components: %d\n", grid->num_components);
+    printf("Start Position: (%d, %d, %d)\n", 
+           grid->start.x, grid->start.y, grid->start.z);
+    printf("======================================\n");
+}
+
+// Save grid to file
+void save_grid_to_file(const Grid* grid, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        warning("Could not save grid to file");
+        return;
+    }
+    
+    fprintf(file, "Grid Dimensions: %dx%dx%d\n", 
+            grid->size_x, grid->size_y, grid->size_z);
+    fprintf(file, "Survivors: %d\n", grid->num_survivors);
+    fprintf(file, "Obstacles: %d\n\n", grid->obstacle_count);
+    
+    for (int z = 0; z < grid->size_z; z++) {
+        fprintf(file, "Layer Z=%d:\n", z);
+        for (int y = 0; y < grid->size_y; y++) {
+            for (int x = 0; x < grid->size_x; x++) {
+                CellType type = grid->cells[x][y][z];
+                switch (type) {
+                    case CELL_EMPTY:    fprintf(file, ". "); break;
+                    case CELL_OBSTACLE: fprintf(file, "# "); break;
+                    case CELL_SURVIVOR: fprintf(file, "S "); break;
+                    case CELL_START:    fprintf(file, "R "); break;
+                }
+            }
+            fprintf(file, "\n");
+        }
+        fprintf(file, "\n");
+    }
+    
+    fclose(file);
+}
+
+// ===== Grid Statistics =====
+
+// Count total obstacles
+int count_obstacles(const Grid* grid) {
+    return grid->obstacle_count;
+}
+
+// Count empty cells
+int count_empty_cells(const Grid* grid) {
+    int count = 0;
+    for (int i = 0; i < grid->total_cells; i++) {
+        if (grid->cell_data[i] == CELL_EMPTY) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Calculate obstacle density
+float calculate_obstacle_density(const Grid* grid) {
+    return (float)grid->obstacle_count / grid->total_cells;
 }
\ No newline at end of file
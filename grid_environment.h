@@ -1,57 +1,158 @@
-#ifndef GRID_ENVIRONMENT_H
-#define GRID_ENVIRONMENT_H
-
-#include "utilities.h"
-
-// ===== Grid Structure =====
-typedef struct {
-    CellType*** cells;       // 3D array of cells
-    int size_x;              // Grid width
-    int size_y;              // Grid height
-    int size_z;              // Grid depth (floors)
-    int total_cells;         // Total number of cells
-    
-    Coordinate start;        // Robot starting position
-    Coordinate* survivors;   // Array of survivor positions
-    int num_survivors;       // Number of survivors
-    int obstacle_count;      // Number of obstacles
-} Grid;
-
-// ===== Grid Creation and Destruction =====
-Grid* create_grid(int size_x, int size_y, int size_z);
-void free_grid(Grid* grid);
-
-// ===== Grid Initialization =====
-void initialize_grid(Grid* grid, const Config* config);
-void place_obstacles(Grid* grid, int obstacle_percent);
-void place_survivors(Grid* grid, int num_survivors);
-void set_start_position(Grid* grid, Coordinate start);
-
-// ===== Grid Queries =====
-CellType get_cell(const Grid* grid, Coordinate coord);
-void set_cell(Grid* grid, Coordinate coord, CellType type);
-int is_valid_coordinate(const Grid* grid, Coordinate coord);
-int is_walkable(const Grid* grid, Coordinate coord);
-int is_obstacle(const Grid* grid, Coordinate coord);
-int is_survivor(const Grid* grid, Coordinate coord);
-
-// ===== Survivor Management =====
-int get_survivor_at(const Grid* grid, Coordinate coord);
-Coordinate get_survivor_position(const Grid* grid, int index);
-int count_survivors_in_area(const Grid* grid, Coordinate center, int radius);
-
-// ===== Neighbor Functions =====
-int get_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors);
-int get_walkable_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors);
-
-// ===== Grid Visualization =====
-void print_grid_layer(const Grid* grid, int z);
-void print_grid_info(const Grid* grid);
-void save_grid_to_file(const Grid* grid, const char* filename);
-
-// ===== Grid Statistics =====
-int count_obstacles(const Grid* grid);
-int count_empty_cells(const Grid* grid);
-float calculate_obstacle_density(const Grid* grid);
-
-#endif // GRID_ENVIRONMENT_H
+#ifndef GRID_ENVIRONMENT_H
+#define GRID_ENVIRONMENT_H
+
+#include "utilities.h"
+
+// ===== Neighbor Directions =====
+// Bit i of a neighbor mask refers to direction i (same order as get_neighbors)
+#define NUM_DIRECTIONS 6
+#define DIR_POS_X 0
+#define DIR_NEG_X 1
+#define DIR_POS_Y 2
+#define DIR_NEG_Y 3
+#define DIR_POS_Z 4
+#define DIR_NEG_Z 5
+
+extern const int DIR_DX[NUM_DIRECTIONS];
+extern const int DIR_DY[NUM_DIRECTIONS];
+extern const int DIR_DZ[NUM_DIRECTIONS];
+
+// ===== Grid Structure =====
+typedef struct {
+    CellType*** cells;       // 3D array of cells (row views into cell_data)
+    CellType* cell_data;     // Flat cell storage, index = (x * size_y + y) * size_z + z
+    int size_x;              // Grid width
+    int size_y;              // Grid height
+    int size_z;              // Grid depth (floors)
+    int total_cells;         // Total number of cells
+    
+    Coordinate start;        // Robot starting position
+    Coordinate* survivors;   // Array of survivor positions
+    int num_survivors;       // Number of survivors
+    int obstacle_count;      // Number of obstacles
+    
+    // Auxiliary per-cell tables (indexed like cell_data)
+    signed char* survivor_map;      // Survivor index at cell (-1 = none)
+    unsigned char* neighbor_mask;   // Bit i set = neighbor in direction i is walkable
+    int* component;                 // Walkable component label (-1 = obstacle)
+    int num_components;             // Number of walkable components
+    int reachable_survivors;        // Survivors in the start cell's component
+    struct DistanceTable* distances; // Survivor distance tables (see distance_tables.h)
+    struct PathHierarchy* hierarchy; // Cluster/portal graph (see path_hierarchy.h)
+    struct LandmarkTable* landmarks; // ALT heuristic fields (see landmarks.h)
+    
+    int version;             // Bumped on every obstacle layout change
+} Grid;
+
+// ===== Obstacle Delta (collapse / clearance event) =====
+typedef struct {
+    Coordinate coord;
+    int blocked;             // 1 = cell becomes obstacle, 0 = cell is cleared
+} CellDelta;
+
+// ===== Grid Creation and Destruction =====
+Grid* create_grid(int size_x, int size_y, int size_z);
+void free_grid(Grid* grid);
+
+// ===== Grid Initialization =====
+void initialize_grid(Grid* grid, const Config* config);
+void place_obstacles(Grid* grid, int obstacle_percent);
+void place_survivors(Grid* grid, int num_survivors);
+void set_start_position(Grid* grid, Coordinate start);
+
+// ===== Auxiliary Tables =====
+void build_grid_tables(Grid* grid);
+unsigned char compute_neighbor_mask(const Grid* grid, int index);
+void get_neighbor_offsets(const Grid* grid, int* offsets);
+
+// ===== Reachability =====
+void label_components(Grid* grid);
+int get_component(const Grid* grid, Coordinate coord);
+int cells_connected(const Grid* grid, Coordinate a, Coordinate b);
+int is_survivor_reachable(const Grid* grid, int survivor_index);
+
+// ===== Cell Indexing =====
+static inline int cell_index(const Grid* grid, Coordinate coord) {
+    return (coord.x * grid->size_y + coord.y) * grid->size_z + coord.z;
+}
+
+static inline Coordinate cell_coordinate(const Grid* grid, int index) {
+    Coordinate c;
+    c.z = index % grid->size_z;
+    index /= grid->size_z;
+    c.y = index % grid->size_y;
+    c.x = index / grid->size_y;
+    return c;
+}
+
+// ===== Cell Ids =====
+// A cell id is the flat cell index as a uint32_t; cell-id paths and the
+// fitness kernels work on these and only convert to x/y/z for output.
+typedef uint32_t CellId;
+#define CELL_ID_NONE UINT32_MAX  // Out-of-grid coordinate
+
+static inline CellId cell_id(const Grid* grid, Coordinate coord) {
+    if (coord.x < 0 || coord.x >= grid->size_x || coord.y < 0 || coord.y >= grid->size_y ||
+        coord.z < 0 || coord.z >= grid->size_z) {
+        return CELL_ID_NONE;
+    }
+    return (CellId)cell_index(grid, coord);
+}
+
+static inline int cell_id_z(const Grid* grid, CellId id) {
+    return (int)(id % (CellId)grid->size_z);
+}
+
+// Out-of-grid ids count as obstacles, like get_cell()
+static inline int cell_id_blocked(const Grid* grid, CellId id) {
+    return id == CELL_ID_NONE || grid->cell_data[id] == CELL_OBSTACLE;
+}
+
+// Survivor index at the cell, or -1
+static inline int survivor_at_id(const Grid* grid, CellId id) {
+    return id == CELL_ID_NONE ? -1 : grid->survivor_map[id];
+}
+
+// One unit step apart: the ids differ by a neighbor offset without
+// wrapping across a row or column
+static inline int cell_ids_adjacent(const Grid* grid, CellId a, CellId b) {
+    if (a == CELL_ID_NONE || b == CELL_ID_NONE) return 0;
+    CellId diff = a > b ? a - b : b - a;
+    CellId column = (CellId)grid->size_z;
+    CellId plane = (CellId)grid->size_y * column;
+    if (diff == 1) return a / column == b / column;
+    if (diff == column) return a / plane == b / plane;
+    return diff == plane;
+}
+
+// ===== Grid Queries =====
+CellType get_cell(const Grid* grid, Coordinate coord);
+void set_cell(Grid* grid, Coordinate coord, CellType type);
+int is_valid_coordinate(const Grid* grid, Coordinate coord);
+int is_walkable(const Grid* grid, Coordinate coord);
+int is_obstacle(const Grid* grid, Coordinate coord);
+int is_survivor(const Grid* grid, Coordinate coord);
+
+// ===== Dynamic Updates =====
+int apply_obstacle_deltas(Grid* grid, CellDelta* deltas, int count);
+
+// ===== Survivor Management =====
+int get_survivor_at(const Grid* grid, Coordinate coord);
+Coordinate get_survivor_position(const Grid* grid, int index);
+int count_survivors_in_area(const Grid* grid, Coordinate center, int radius);
+
+// ===== Neighbor Functions =====
+int get_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors);
+int get_walkable_neighbors(const Grid* grid, Coordinate coord, Coordinate* neighbors);
+
+// ===== Grid Visualization =====
+void print_grid_layer(const Grid* grid, int z);
+void print_grid_info(const Grid* grid);
+void save_grid_to_file(const Grid* grid, const char* filename);
+
+// ===== Grid Statistics =====
+int count_obstacles(const Grid* grid);
+int count_empty_cells(const Grid* grid);
+float calculate_obstacle_density(const Grid* grid);
+
+#endif // GRID_ENVIRONMENT_H
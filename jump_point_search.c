@@ -0,0 +1,174 @@
+#include "jump_point_search.h"
+#include "search_queue.h"
+
+// ===== Jumping =====
+
+typedef struct {
+    const unsigned char* mask;   // Grid neighbor masks
+    int offsets[NUM_DIRECTIONS];
+    int goal;
+} JumpScan;
+
+static inline int axis_of(int d) {
+    return d >> 1;
+}
+
+// Scan from 'cell' in direction d. Returns the first jump point: the goal,
+// a cell with a forced senior-axis neighbor, or a cell from which a
+// junior-axis scan finds a jump point. Returns -1 on hitting a wall.
+static int jump(const JumpScan* scan, int cell, int d) {
+    int first_junior = (axis_of(d) + 1) * 2;
+    
+    for (;;) {
+        if (!(scan->mask[cell] & (1 << d))) return -1;
+        
+        int prev = cell;
+        cell += scan->offsets[d];
+        if (cell == scan->goal) return cell;
+        
+        // Forced: senior neighbor open here but closed beside the previous cell
+        for (int b = 0; b < first_junior - 2; b++) {
+            if ((scan->mask[cell] & (1 << b)) && !(scan->mask[prev] & (1 << b))) {
+                return cell;
+            }
+        }
+        
+        // Natural turns onto junior axes
+        for (int b = first_junior; b < NUM_DIRECTIONS; b++) {
+            if (jump(scan, cell, b) >= 0) return cell;
+        }
+    }
+}
+
+// Directions to scan when expanding 'cell', reached by moving in 'arrival'
+// (-1 for the start cell, which scans every open direction)
+static unsigned char successor_directions(const JumpScan* scan, int cell, int arrival) {
+    unsigned char open = scan->mask[cell];
+    if (arrival < 0) return open;
+    
+    int axis = axis_of(arrival);
+    int prev = cell - scan->offsets[arrival];
+    unsigned char dirs = (unsigned char)(1 << arrival);
+    
+    for (int b = (axis + 1) * 2; b < NUM_DIRECTIONS; b++) {
+        dirs |= (unsigned char)(1 << b);
+    }
+    for (int b = 0; b < axis * 2; b++) {
+        if (!(scan->mask[prev] & (1 << b))) {
+            dirs |= (unsigned char)(1 << b);
+        }
+    }
+    return dirs & open;
+}
+
+// ===== Path Reconstruction =====
+
+// Parents link jump points; fill in the straight runs between them
+static Path* build_jump_path(const Grid* grid, const SearchContext* ctx, int goal) {
+    int length = (int)ctx->g[goal] + 1;
+    Path* path = create_path(length);
+    path->length = length;
+    
+    int i = length - 1;
+    int cell = goal;
+    path->coordinates[i--] = cell_coordinate(grid, cell);
+    
+    while (ctx->parent[cell] >= 0) {
+        int parent = ctx->parent[cell];
+        Coordinate from = cell_coordinate(grid, cell);
+        Coordinate to = cell_coordinate(grid, parent);
+        int steps = manhattan_distance(from, to);
+        int step = (parent - cell) / steps;
+        
+        for (int k = 1; k <= steps; k++) {
+            path->coordinates[i--] = cell_coordinate(grid, cell + k * step);
+        }
+        cell = parent;
+    }
+    
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
+
+// ===== Jump Point Search =====
+
+Path* find_path_jps(const Grid* grid, Coordinate start, Coordinate goal,
+                    SearchContext* ctx) {
+    if (!is_valid_coordinate(grid, start) || !is_valid_coordinate(grid, goal)) {
+        return NULL;
+    }
+    
+    if (is_obstacle(grid, goal) && !is_survivor(grid, goal)) {
+        return NULL;
+    }
+    
+    if (!cells_connected(grid, start, goal)) {
+        return NULL;
+    }
+    
+    if (!ctx || ctx->num_cells != grid->total_cells) {
+        ctx = default_search_context(grid);
+    }
+    begin_search(ctx);
+    
+    JumpScan scan;
+    scan.mask = grid->neighbor_mask;
+    scan.goal = cell_index(grid, goal);
+    get_neighbor_offsets(grid, scan.offsets);
+    
+    // Arrival direction per jump point lives in the (unused) bucket keys
+    int* arrival = ctx->queue_key;
+    
+    IndexedHeap heap;
+    heap_init(&heap, ctx->queue_items, ctx->queue_position, ctx->f, ctx->g);
+    
+    int start_cell = cell_index(grid, start);
+    ctx->g[start_cell] = 0.0f;
+    ctx->f[start_cell] = heuristic_manhattan(start, goal);
+    ctx->parent[start_cell] = -1;
+    arrival[start_cell] = -1;
+    set_search_state(ctx, start_cell, SEARCH_OPEN);
+    heap_push(&heap, start_cell);
+    
+    for (;;) {
+        int current = heap_pop(&heap);
+        if (current < 0) break;
+        ctx->expansions++;
+        
+        if (current == scan.goal) {
+            return build_jump_path(grid, ctx, current);
+        }
+        ctx->state[current] = SEARCH_CLOSED;
+        
+        Coordinate current_pos = cell_coordinate(grid, current);
+        unsigned char dirs = successor_directions(&scan, current, arrival[current]);
+        
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(dirs & (1 << d))) continue;
+            
+            int next = jump(&scan, current, d);
+            if (next < 0) continue;
+            
+            unsigned char state = search_state(ctx, next);
+            if (state == SEARCH_CLOSED) continue;
+            
+            Coordinate next_pos = cell_coordinate(grid, next);
+            float tentative_g = ctx->g[current] + manhattan_distance(current_pos, next_pos);
+            if (state == SEARCH_OPEN && tentative_g >= ctx->g[next]) continue;
+            
+            ctx->g[next] = tentative_g;
+            ctx->f[next] = tentative_g + heuristic_manhattan(next_pos, goal);
+            ctx->parent[next] = current;
+            arrival[next] = d;
+            
+            if (state == SEARCH_UNSEEN) {
+                set_search_state(ctx, next, SEARCH_OPEN);
+                heap_push(&heap, next);
+            } else {
+                heap_decrease(&heap, next);
+            }
+        }
+    }
+    
+    return NULL;
+}
@@ -0,0 +1,19 @@
+#ifndef JUMP_POINT_SEARCH_H
+#define JUMP_POINT_SEARCH_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== 6-Connected Jump Point Search =====
+// Uniform-cost A* that only expands jump points. Among equal-length paths
+// it considers the canonical one whose moves follow the axis order
+// x > y > z: a move along a junior axis may only be followed by a move
+// along a more senior axis where the cell that would have allowed the
+// senior move earlier is blocked (a forced neighbor). Path lengths are
+// identical to find_path_astar().
+
+Path* find_path_jps(const Grid* grid, Coordinate start, Coordinate goal,
+                    SearchContext* ctx);
+
+#endif // JUMP_POINT_SEARCH_H
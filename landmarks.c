@@ -0,0 +1,229 @@
+#include "landmarks.h"
+
+static int configured_landmarks = 0;
+
+void configure_landmarks(const Config* config) {
+    configured_landmarks = config->landmark_count;
+    if (configured_landmarks < 0) configured_landmarks = 0;
+    if (configured_landmarks > MAX_LANDMARKS) configured_landmarks = MAX_LANDMARKS;
+}
+
+// ===== Construction =====
+
+// BFS from one landmark into slot 'slot' of every cell's distance row
+static void sweep_landmark(const Grid* grid, LandmarkTable* table, int slot,
+                           const int* offsets, int* queue) {
+    uint16_t* distance = table->distance;
+    int stride = table->count;
+    int origin = table->cells[slot];
+
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = origin;
+    distance[(size_t)origin * stride + slot] = 0;
+
+    while (head < tail) {
+        int cell = queue[head++];
+        uint16_t d = distance[(size_t)cell * stride + slot];
+        uint16_t next_d = d < LANDMARK_MAX_DISTANCE ? d + 1 : LANDMARK_MAX_DISTANCE;
+        unsigned char mask = grid->neighbor_mask[cell];
+
+        for (int dir = 0; dir < NUM_DIRECTIONS; dir++) {
+            if (!(mask & (1 << dir))) continue;
+            int next = cell + offsets[dir];
+            uint16_t* slot_d = &distance[(size_t)next * stride + slot];
+            if (*slot_d != LANDMARK_UNREACHABLE) continue;
+            *slot_d = next_d;
+            queue[tail++] = next;
+        }
+    }
+}
+
+// Farthest-point placement: the first landmark is the cell farthest from
+// the start, each next one maximises its distance to those already chosen.
+LandmarkTable* build_landmark_table(const Grid* grid, int count) {
+    if (count <= 0) return NULL;
+    if (count > MAX_LANDMARKS) count = MAX_LANDMARKS;
+
+    LandmarkTable* table = (LandmarkTable*)safe_malloc(sizeof(LandmarkTable));
+    table->count = count;
+    table->num_cells = grid->total_cells;
+    table->grid_version = grid->version;
+    table->distance = (uint16_t*)safe_malloc((size_t)grid->total_cells * count * sizeof(uint16_t));
+    memset(table->distance, 0xFF, (size_t)grid->total_cells * count * sizeof(uint16_t));
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    uint16_t* nearest = (uint16_t*)safe_malloc(grid->total_cells * sizeof(uint16_t));
+
+    // Seed: distances from the start, stored temporarily in slot 0
+    table->cells[0] = cell_index(grid, grid->start);
+    sweep_landmark(grid, table, 0, offsets, queue);
+    for (int i = 0; i < grid->total_cells; i++) {
+        nearest[i] = table->distance[(size_t)i * count];
+        table->distance[(size_t)i * count] = LANDMARK_UNREACHABLE;
+    }
+
+    for (int slot = 0; slot < count; slot++) {
+        int best = table->cells[0];
+        int best_distance = -1;
+        for (int i = 0; i < grid->total_cells; i++) {
+            if (nearest[i] != LANDMARK_UNREACHABLE && nearest[i] > best_distance) {
+                best_distance = nearest[i];
+                best = i;
+            }
+        }
+
+        table->cells[slot] = best;
+        sweep_landmark(grid, table, slot, offsets, queue);
+        for (int i = 0; i < grid->total_cells; i++) {
+            uint16_t d = table->distance[(size_t)i * count + slot];
+            if (d < nearest[i]) nearest[i] = d;
+        }
+    }
+
+    free(queue);
+    free(nearest);
+    return table;
+}
+
+void free_landmark_table(LandmarkTable* table) {
+    if (!table) return;
+    free(table->distance);
+    free(table);
+}
+
+// Cached on the grid (patched by update_landmark_table(), rebuilt after any
+// other layout change); NULL when landmarks are disabled
+const LandmarkTable* get_landmark_table(const Grid* grid) {
+    Grid* cache = (Grid*)grid;
+    LandmarkTable* table = cache->landmarks;
+
+    if (configured_landmarks == 0) return NULL;
+    if (!table || table->grid_version != grid->version || table->count != configured_landmarks ||
+        table->num_cells != grid->total_cells) {
+        free_landmark_table(table);
+        cache->landmarks = build_landmark_table(grid, configured_landmarks);
+    }
+    return cache->landmarks;
+}
+
+// ===== Incremental Update =====
+// Same rules as the distance tables (see update_distance_table), checked
+// directly on the stored distances: a blocked cell matters only if a
+// neighbour one hop farther has no other neighbour at its own distance,
+// and a cleared cell only if its walkable neighbours are not all reached
+// within two hops of each other. Landmarks failing either test are
+// re-swept; a blocked landmark cell leaves the table to a full rebuild.
+
+static int repair_landmark(const Grid* grid, LandmarkTable* table, int slot,
+                           const CellDelta* deltas, int count, const int* offsets) {
+    uint16_t* distance = table->distance;
+    int stride = table->count;
+
+    for (int i = 0; i < count; i++) {
+        if (!deltas[i].blocked) continue;
+        int cell = cell_index(grid, deltas[i].coord);
+        uint16_t d = distance[(size_t)cell * stride + slot];
+        if (d == LANDMARK_UNREACHABLE) continue;
+        if (d >= LANDMARK_MAX_DISTANCE - 1) return 0;
+
+        unsigned char mask = grid->neighbor_mask[cell];
+        for (int dir = 0; dir < NUM_DIRECTIONS; dir++) {
+            if (!(mask & (1 << dir))) continue;
+            int child = cell + offsets[dir];
+            if (distance[(size_t)child * stride + slot] != d + 1) continue;
+
+            unsigned char child_mask = grid->neighbor_mask[child];
+            int supported = 0;
+            for (int e = 0; e < NUM_DIRECTIONS && !supported; e++) {
+                if (!(child_mask & (1 << e))) continue;
+                supported = distance[(size_t)(child + offsets[e]) * stride + slot] == d;
+            }
+            if (!supported) return 0;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (!deltas[i].blocked) continue;
+        distance[(size_t)cell_index(grid, deltas[i].coord) * stride + slot] = LANDMARK_UNREACHABLE;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (deltas[i].blocked) continue;
+        int cell = cell_index(grid, deltas[i].coord);
+        unsigned char mask = grid->neighbor_mask[cell];
+        int nearest = LANDMARK_UNREACHABLE;
+        int farthest = -1;
+
+        for (int dir = 0; dir < NUM_DIRECTIONS; dir++) {
+            if (!(mask & (1 << dir))) continue;
+            int d = distance[(size_t)(cell + offsets[dir]) * stride + slot];
+            if (d < nearest) nearest = d;
+            if (d > farthest) farthest = d;
+        }
+
+        if (nearest == LANDMARK_UNREACHABLE) continue;   // Still cut off
+        if (farthest > nearest + 2 || nearest >= LANDMARK_MAX_DISTANCE - 1) return 0;
+        distance[(size_t)cell * stride + slot] = (uint16_t)(nearest + 1);
+    }
+    return 1;
+}
+
+// 'deltas' are the distinct cells apply_obstacle_deltas() changed since
+// 'base_version'; a table built for another version is left to
+// get_landmark_table() to rebuild
+void update_landmark_table(Grid* grid, const CellDelta* deltas, int count, int base_version) {
+    LandmarkTable* table = grid->landmarks;
+    if (!table || table->grid_version != base_version ||
+        table->num_cells != grid->total_cells) {
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int cell = cell_index(grid, deltas[i].coord);
+        for (int slot = 0; slot < table->count; slot++) {
+            if (table->cells[slot] == cell) return;
+        }
+    }
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    int* queue = NULL;
+
+    for (int slot = 0; slot < table->count; slot++) {
+        if (repair_landmark(grid, table, slot, deltas, count, offsets)) continue;
+
+        if (!queue) queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+        for (int i = 0; i < grid->total_cells; i++) {
+            table->distance[(size_t)i * table->count + slot] = LANDMARK_UNREACHABLE;
+        }
+        sweep_landmark(grid, table, slot, offsets, queue);
+    }
+
+    free(queue);
+    table->grid_version = grid->version;
+}
+
+// ===== Heuristic =====
+
+void landmark_goal(const LandmarkTable* table, const Grid* grid, int goal_cell,
+                   LandmarkGoal* out) {
+    out->goal = cell_coordinate(grid, goal_cell);
+    memcpy(out->distance, &table->distance[(size_t)goal_cell * table->count],
+           table->count * sizeof(uint16_t));
+}
+
+// max(Manhattan, max_L |d(L,goal) - d(L,cell)|)
+int landmark_heuristic(const LandmarkTable* table, const LandmarkGoal* goal,
+                       int cell, Coordinate pos) {
+    int h = manhattan_distance(pos, goal->goal);
+    const uint16_t* row = &table->distance[(size_t)cell * table->count];
+
+    for (int i = 0; i < table->count; i++) {
+        if (row[i] == LANDMARK_UNREACHABLE || goal->distance[i] == LANDMARK_UNREACHABLE) continue;
+        int bound = abs((int)goal->distance[i] - (int)row[i]);
+        if (bound > h) h = bound;
+    }
+    return h;
+}
@@ -0,0 +1,48 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+
+// ===== ALT Landmark Heuristic =====
+// BFS distance fields from a few well-spread landmark cells. For any
+// landmark L the triangle inequality gives |d(L,goal) - d(L,n)| <= d(n,goal),
+// so the maximum over landmarks (and Manhattan distance) is an admissible,
+// consistent A* heuristic that sees walls and collapsed floors.
+//
+// Distances are uint16, stored cell-major (all landmarks of one cell are
+// adjacent) so one heuristic evaluation touches one cache line.
+
+#define MAX_LANDMARKS 16
+#define LANDMARK_UNREACHABLE 0xFFFF
+#define LANDMARK_MAX_DISTANCE 0xFFFE   // Longer distances saturate (still admissible)
+
+struct LandmarkTable {
+    int count;
+    int num_cells;
+    int grid_version;            // Grid version the fields were built for
+    int cells[MAX_LANDMARKS];    // Landmark cell indices
+    uint16_t* distance;          // num_cells x count
+};
+typedef struct LandmarkTable LandmarkTable;
+
+// Goal-side landmark distances, computed once per query
+typedef struct {
+    Coordinate goal;
+    uint16_t distance[MAX_LANDMARKS];
+} LandmarkGoal;
+
+// ===== Construction =====
+void configure_landmarks(const Config* config);
+LandmarkTable* build_landmark_table(const Grid* grid, int count);
+void free_landmark_table(LandmarkTable* table);
+const LandmarkTable* get_landmark_table(const Grid* grid);
+void update_landmark_table(Grid* grid, const CellDelta* deltas, int count, int base_version);
+
+// ===== Heuristic =====
+void landmark_goal(const LandmarkTable* table, const Grid* grid, int goal_cell,
+                   LandmarkGoal* out);
+int landmark_heuristic(const LandmarkTable* table, const LandmarkGoal* goal,
+                       int cell, Coordinate pos);
+
+#endif // LANDMARKS_H
@@ -0,0 +1,318 @@
+#include "local_search.h"
+#include "fitness.h"
+
+// ===== Visit Orders =====
+
+// Survivors in the order the path first reaches them. Survivors that
+// cannot be reached from the start are left out (no leg can join them).
+int extract_visit_order(const Grid* grid, const Path* path, int* order) {
+    const DistanceTable* table = get_distance_table(grid);
+    uint64_t seen = 0;
+    int count = 0;
+
+    for (int i = 0; i < path->length; i++) {
+        if (!is_valid_coordinate(grid, path->coordinates[i])) continue;
+        int survivor = grid->survivor_map[cell_index(grid, path->coordinates[i])];
+        if (survivor < 0 || (seen & (1ULL << survivor))) continue;
+
+        seen |= 1ULL << survivor;
+        if (source_distance(table, table->start_source, survivor) >= 0) {
+            order[count++] = survivor;
+        }
+    }
+    return count;
+}
+
+// Steps of the open tour start -> order[0] -> ... -> order[count - 1]
+int visit_order_cost(const DistanceTable* table, const int* order, int count) {
+    int cost = 0;
+    int previous = table->start_source;
+    for (int i = 0; i < count; i++) {
+        cost += source_distance(table, previous, order[i]);
+        previous = order[i];
+    }
+    return cost;
+}
+
+// ===== 2-opt / Or-opt =====
+
+// Tour positions: 0 is the start, 1..count the visits. Position count + 1
+// does not exist (open tour), so edges out of the last visit cost nothing.
+static inline int node_at(const DistanceTable* table, const int* order, int count, int pos) {
+    if (pos == 0) return table->start_source;
+    if (pos > count) return -1;
+    return order[pos - 1];
+}
+
+static inline int leg(const DistanceTable* table, int a, int b) {
+    if (a < 0 || b < 0) return 0;
+    return source_distance(table, a, b);
+}
+
+static int two_opt_pass(const DistanceTable* table, int* order, int count) {
+    int improved = 0;
+
+    for (int i = 1; i < count; i++) {
+        for (int j = i + 1; j <= count; j++) {
+            int before = node_at(table, order, count, i - 1);
+            int first = node_at(table, order, count, i);
+            int last = node_at(table, order, count, j);
+            int after = node_at(table, order, count, j + 1);
+
+            int delta = leg(table, before, last) + leg(table, first, after) -
+                        leg(table, before, first) - leg(table, last, after);
+            if (delta >= 0) continue;
+
+            for (int a = i - 1, b = j - 1; a < b; a++, b--) {
+                int swap = order[a];
+                order[a] = order[b];
+                order[b] = swap;
+            }
+            improved = 1;
+        }
+    }
+    return improved;
+}
+
+// Move the run at positions [i, i + length) between positions p and p + 1
+static int or_opt_pass(const DistanceTable* table, int* order, int count) {
+    int improved = 0;
+    int moved[3];
+    int rest[MAX_SURVIVORS];
+
+    for (int length = 1; length <= 3 && length < count; length++) {
+        for (int i = 1; i + length - 1 <= count; i++) {
+            int j = i + length - 1;
+            int before = node_at(table, order, count, i - 1);
+            int first = node_at(table, order, count, i);
+            int last = node_at(table, order, count, j);
+            int after = node_at(table, order, count, j + 1);
+            int gain = leg(table, before, first) + leg(table, last, after) -
+                       leg(table, before, after);
+
+            int best_delta = 0;
+            int best_p = -1;
+            int best_reversed = 0;
+
+            for (int p = 0; p <= count; p++) {
+                if (p >= i - 1 && p <= j) continue;
+                int x = node_at(table, order, count, p);
+                int y = node_at(table, order, count, p + 1);
+                int removed = leg(table, x, y);
+
+                int forward = leg(table, x, first) + leg(table, last, y) - removed - gain;
+                int backward = leg(table, x, last) + leg(table, first, y) - removed - gain;
+                if (forward < best_delta) {
+                    best_delta = forward;
+                    best_p = p;
+                    best_reversed = 0;
+                }
+                if (backward < best_delta) {
+                    best_delta = backward;
+                    best_p = p;
+                    best_reversed = 1;
+                }
+            }
+            if (best_p < 0) continue;
+
+            // Rebuild: everything but the run, with the run inserted after p
+            for (int k = 0; k < length; k++) {
+                moved[k] = order[i - 1 + (best_reversed ? length - 1 - k : k)];
+            }
+            int n = 0;
+            for (int pos = 1; pos <= count; pos++) {
+                if (pos < i || pos > j) rest[n++] = order[pos - 1];
+            }
+            int insert_at = best_p < i ? best_p : best_p - length;
+            int out = 0;
+            for (int k = 0; k < insert_at; k++) order[out++] = rest[k];
+            for (int k = 0; k < length; k++) order[out++] = moved[k];
+            for (int k = insert_at; k < n; k++) order[out++] = rest[k];
+            improved = 1;
+        }
+    }
+    return improved;
+}
+
+// ===== Cheapest Insertion =====
+
+// Add reachable survivors the order skips, each where it lengthens the
+// tour least, while the tour stays within 'max_cost' steps
+int insert_missing_survivors(const DistanceTable* table, int* order, int count,
+                             int max_cost) {
+    int cost = visit_order_cost(table, order, count);
+    uint64_t present = 0;
+    for (int i = 0; i < count; i++) present |= 1ULL << order[i];
+
+    for (;;) {
+        int best_delta = -1;
+        int best_survivor = -1;
+        int best_p = 0;
+
+        for (int s = 0; s < table->start_source; s++) {
+            if ((present & (1ULL << s)) ||
+                source_distance(table, table->start_source, s) < 0) {
+                continue;
+            }
+            for (int p = 0; p <= count; p++) {
+                int x = node_at(table, order, count, p);
+                int y = node_at(table, order, count, p + 1);
+                int delta = leg(table, x, s) + leg(table, s, y) - leg(table, x, y);
+                if (best_survivor < 0 || delta < best_delta) {
+                    best_delta = delta;
+                    best_survivor = s;
+                    best_p = p;
+                }
+            }
+        }
+        if (best_survivor < 0 || cost + best_delta > max_cost) break;
+
+        for (int k = count; k > best_p; k--) order[k] = order[k - 1];
+        order[best_p] = best_survivor;
+        count++;
+        cost += best_delta;
+        present |= 1ULL << best_survivor;
+    }
+    return count;
+}
+
+// ===== Local Search =====
+
+// Alternate both neighbourhoods until neither finds a shorter tour;
+// returns the number of steps saved
+int improve_visit_order(const DistanceTable* table, int* order, int count) {
+    if (count < 2) return 0;
+
+    int initial = visit_order_cost(table, order, count);
+    int improved = 1;
+    while (improved) {
+        improved = two_opt_pass(table, order, count);
+        improved |= or_opt_pass(table, order, count);
+    }
+    return initial - visit_order_cost(table, order, count);
+}
+
+// ===== Re-stitching =====
+
+// Where 'original' reaches each survivor first, and which survivor it
+// reaches next (the start cell is node start_source at index 0)
+typedef struct {
+    int visit_at[MAX_SURVIVORS + 1];
+    int next[MAX_SURVIVORS + 1];
+    int last;
+} OriginalVisits;
+
+static void index_original(const Grid* grid, const DistanceTable* table,
+                           const Path* original, OriginalVisits* visits) {
+    for (int s = 0; s <= table->start_source; s++) {
+        visits->visit_at[s] = -1;
+        visits->next[s] = -1;
+    }
+    visits->visit_at[table->start_source] = 0;
+    visits->last = table->start_source;
+
+    for (int i = 0; i < original->length; i++) {
+        if (!is_valid_coordinate(grid, original->coordinates[i])) continue;
+        int survivor = grid->survivor_map[cell_index(grid, original->coordinates[i])];
+        if (survivor < 0 || visits->visit_at[survivor] >= 0) continue;
+
+        visits->visit_at[survivor] = i;
+        visits->next[visits->last] = survivor;
+        visits->last = survivor;
+    }
+}
+
+// Append original cells strictly after index 'from' up to 'to' inclusive
+// (walking backwards when to < from)
+static void append_original(Path* path, const Path* original, int from, int to) {
+    int step = to > from ? 1 : -1;
+    for (int i = from + step; i != to + step; i += step) {
+        add_coordinate_to_path(path, original->coordinates[i]);
+    }
+}
+
+// Path through the visits in order. With an 'original', every leg whose
+// two ends were consecutive visits there (either direction) reuses the
+// original cells, and so does the tail after an unchanged last visit;
+// the remaining legs are shortest paths. Reusing keeps the coverage the
+// original's detours earned.
+Path* stitch_visit_order(const Grid* grid, const DistanceTable* table,
+                         const int* order, int count, const Path* original) {
+    OriginalVisits visits;
+    if (original) index_original(grid, table, original, &visits);
+
+    Path* path = create_path(visit_order_cost(table, order, count) + 1);
+    add_coordinate_to_path(path, grid->start);
+
+    int previous = table->start_source;
+    for (int i = 0; i < count; i++) {
+        int current = order[i];
+        if (original && visits.next[previous] == current) {
+            append_original(path, original, visits.visit_at[previous], visits.visit_at[current]);
+        } else if (original && visits.next[current] == previous) {
+            append_original(path, original, visits.visit_at[previous], visits.visit_at[current]);
+        } else {
+            Path* segment = path_to_source(grid, table, path->coordinates[path->length - 1],
+                                           current);
+            if (!segment) {
+                free_path(path);
+                return NULL;
+            }
+            for (int k = 1; k < segment->length; k++) {
+                add_coordinate_to_path(path, segment->coordinates[k]);
+            }
+            free_path(segment);
+        }
+        previous = current;
+    }
+
+    if (original && count > 0 && previous == visits.last) {
+        append_original(path, original, visits.visit_at[previous], original->length - 1);
+    }
+    return path;
+}
+
+static Path* score_candidate(Path* candidate, const Grid* grid, const Config* config) {
+    if (!candidate) return NULL;
+    if (candidate->length > MAX_PATH_LENGTH) {
+        free_path(candidate);
+        return NULL;
+    }
+    update_path_fitness(candidate, grid, config);
+    return candidate;
+}
+
+Path* memetic_improve_path(const Path* path, const Grid* grid, const Config* config) {
+    if (!path || path->length == 0 ||
+        !coordinates_equal(path->coordinates[0], grid->start)) {
+        return NULL;
+    }
+
+    const DistanceTable* table = get_distance_table(grid);
+    int order[MAX_SURVIVORS];
+    int count = extract_visit_order(grid, path, order);
+
+    // Complete the tour first, then shorten it: a skipped survivor is
+    // worth far more than the steps 2-opt/Or-opt save
+    count = insert_missing_survivors(table, order, count, MAX_PATH_LENGTH - 1);
+    if (count == 0) return NULL;
+    improve_visit_order(table, order, count);
+
+    // Shortest legs everywhere, or original cells wherever the order kept
+    // them; coverage decides which scores higher, and the winner still has
+    // to beat the original
+    Path* best = NULL;
+    for (int reuse = 0; reuse <= 1; reuse++) {
+        Path* candidate = score_candidate(
+            stitch_visit_order(grid, table, order, count, reuse ? path : NULL), grid, config);
+        if (!candidate) continue;
+        if (candidate->fitness > path->fitness &&
+            (!best || candidate->fitness > best->fitness)) {
+            free_path(best);
+            best = candidate;
+        } else {
+            free_path(candidate);
+        }
+    }
+    return best;
+}
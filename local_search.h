@@ -0,0 +1,29 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+#include "distance_tables.h"
+
+// ===== Memetic Local Search =====
+// Works on the order in which a path first reaches each survivor rather
+// than on its raw cells. The order is improved with 2-opt (reverse a run
+// of visits) and Or-opt (move a run of 1-3 visits elsewhere, either way
+// round), scored by survivor-to-survivor shortest distances, and the path
+// is then rebuilt as shortest legs between consecutive visits. Survivors
+// the path misses are first added by cheapest insertion.
+
+int extract_visit_order(const Grid* grid, const Path* path, int* order);
+int visit_order_cost(const DistanceTable* table, const int* order, int count);
+int insert_missing_survivors(const DistanceTable* table, int* order, int count,
+                             int max_cost);
+int improve_visit_order(const DistanceTable* table, int* order, int count);
+Path* stitch_visit_order(const Grid* grid, const DistanceTable* table,
+                         const int* order, int count, const Path* original);
+
+// Improved copy of 'path' (scored), or NULL when local search cannot
+// raise its fitness
+Path* memetic_improve_path(const Path* path, const Grid* grid, const Config* config);
+
+#endif // LOCAL_SEARCH_H
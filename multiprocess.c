@@ -83,44 +83,71 @@ void sem_signal(int sem_id, int sem_num) {
 
 // ===== Path Transfer Functions =====
 
-void path_to_shared(const Path* path, SharedPath* shared_path) {
-    if (!path || !shared_path) return;
+int path_to_shared(const Path* path, SharedPath* shared_path, SharedData* spill) {
+    if (!path || !shared_path) return 0;
     
-    shared_path->length = path->length;
+    // Longer paths are truncated; the length must match what was encoded
+    int copy_len = path->length < MAX_PATH_LENGTH ? path->length : MAX_PATH_LENGTH;
+    int stored = encoded_prefix_length(path->coordinates, copy_len, SHARED_MOVE_BYTES);
+    if (stored < 0) {
+        error_exit("Path coordinates exceed the int16 range of the move encoding");
+    }
+    
+    unsigned char* moves = shared_path->moves;
+    int capacity = SHARED_MOVE_BYTES;
+    shared_path->spill_offset = 0;
+    if (stored < copy_len && spill) {
+        int room = ESCAPE_AREA_BYTES - spill->escape_used;
+        int spilled = encoded_prefix_length(path->coordinates, copy_len, room);
+        if (spilled < 0) {
+            error_exit("Path coordinates exceed the int16 range of the move encoding");
+        }
+        if (spilled == copy_len) {
+            moves = spill->escape_area + spill->escape_used;
+            capacity = room;
+            shared_path->spill_offset = (long)(moves - (unsigned char*)shared_path);
+            stored = copy_len;
+        }
+    }
+    
+    shared_path->start = stored > 0 ? path->coordinates[0] : create_coordinate(0, 0, 0);
+    shared_path->length = stored;
+    shared_path->encoded_bytes = encode_path_moves(path->coordinates, stored, moves, capacity);
+    if (shared_path->spill_offset) {
+        spill->escape_used += shared_path->encoded_bytes;
+    }
     shared_path->survivors_reached = path->survivors_reached;
     shared_path->fitness = path->fitness;
     shared_path->collision_count = path->collision_count;
-    
-    int copy_len = path->length < MAX_PATH_LENGTH ? path->length : MAX_PATH_LENGTH;
-    memcpy(shared_path->coordinates, path->coordinates, 
-           copy_len * sizeof(Coordinate));
+    return stored;
 }
 
 void shared_to_path(const SharedPath* shared_path, Path* path) {
     if (!shared_path || !path) return;
     
-    path->length = shared_path->length;
+    // The old cells are overwritten, so none need to move on growth
+    path->length = 0;
+    make_path_writable(path);
+    if (shared_path->length > path->capacity) {
+        reserve_path_capacity(path, shared_path->length + 100);
+    }
+    
     path->survivors_reached = shared_path->survivors_reached;
     path->fitness = shared_path->fitness;
     path->collision_count = shared_path->collision_count;
-    
-    if (path->length > path->capacity) {
-        path->capacity = path->length + 100;
-        path->coordinates = (Coordinate*)realloc(path->coordinates,
-                                                 path->capacity * sizeof(Coordinate));
-    }
-    
-    memcpy(path->coordinates, shared_path->coordinates,
-           path->length * sizeof(Coordinate));
+    path->length = decode_path_moves(shared_path->start, shared_path_moves(shared_path),
+                                     shared_path->encoded_bytes, shared_path->length,
+                                     path->coordinates);
 }
 
 void copy_population_to_shared(Path** population, int pop_size, SharedData* shared_data) {
     if (!population || !shared_data) return;
     
     shared_data->population_size = pop_size;
+    shared_data->escape_used = 0;
     
     for (int i = 0; i < pop_size && i < MAX_POPULATION; i++) {
-        path_to_shared(population[i], &shared_data->paths[i]);
+        path_to_shared(population[i], &shared_data->paths[i], shared_data);
     }
 }
 
@@ -132,6 +159,23 @@ void copy_population_from_shared(Path** population, int pop_size, SharedData* sh
     }
 }
 
+// Evaluation leaves the cells untouched, so only the scores come back. A
+// path longer than MAX_PATH_LENGTH was sent (and scored) as its prefix, so
+// the master copy is cut to that prefix to match its score.
+void copy_scores_from_shared(Path** population, int pop_size, const SharedData* shared_data) {
+    if (!population || !shared_data) return;
+    
+    for (int i = 0; i < pop_size && i < MAX_POPULATION; i++) {
+        const SharedPath* sp = &shared_data->paths[i];
+        if (population[i]->length > sp->length) {
+            population[i]->length = sp->length;
+        }
+        population[i]->survivors_reached = sp->survivors_reached;
+        population[i]->collision_count = sp->collision_count;
+        population[i]->fitness = sp->fitness;
+    }
+}
+
 // ===== Work Distribution =====
 
 void distribute_work(SharedData* shared_data, int pop_size, int num_workers) {
@@ -140,6 +184,7 @@ void distribute_work(SharedData* shared_data, int pop_size, int num_workers) {
     shared_data->num_workers = num_workers;
     shared_data->workers_completed = 0;
     shared_data->work_ready = 1;
+    shared_data->work_batch++;
     
     int paths_per_worker = pop_size / num_workers;
     int remainder = pop_size % num_workers;
@@ -180,8 +225,106 @@ void wait_for_workers(SharedData* shared_data, int sem_id, int num_workers) {
 
 // ===== Worker Process =====
 
+// Score one shared path in place and fold it into the best-so-far. The
+// path is decoded straight into cell ids; no coordinates are built.
+static void evaluate_shared_path(SharedData* shared_data, int sem_id, int index,
+                                 const Grid* grid, const Config* config) {
+    SharedPath* sp = &shared_data->paths[index];
+    CellId cells[MAX_PATH_LENGTH];
+    
+    CellPath temp_path;
+    temp_path.cells = cells;
+    temp_path.length = decode_path_cells(grid, sp->start, shared_path_moves(sp), sp->encoded_bytes,
+                                         sp->length, cells);
+    temp_path.capacity = MAX_PATH_LENGTH;
+    update_cell_path_fitness(&temp_path, grid, config);
+    
+    // Update shared memory
+    sem_wait(sem_id, 0);
+    sp->survivors_reached = temp_path.survivors_reached;
+    sp->collision_count = temp_path.collision_count;
+    sp->fitness = temp_path.fitness;
+    
+    // Track best fitness
+    if (temp_path.fitness > shared_data->best_fitness) {
+        shared_data->best_fitness = temp_path.fitness;
+        shared_data->best_path_index = index;
+    }
+    sem_signal(sem_id, 0);
+}
+
+// Initial paths go out strided (worker w builds w, w + n, ...) so the
+// expensive greedy tours at the front are spread over the pool. The greedy
+// tour is deterministic, so each worker builds it at most once. Each random
+// walk draws from its slot's own stream, so the population does not depend
+// on the number of workers.
+static void generate_shared_paths(SharedData* shared_data, int sem_id, int worker_id,
+                                  const Grid* grid, const Config* config) {
+    int stride = shared_data->num_workers;
+    int count = shared_data->population_size;
+    int greedy_count = shared_data->greedy_count;
+    Path* greedy = NULL;
+    
+    for (int i = worker_id; i < count; i += stride) {
+        if (i < greedy_count) {
+            if (!greedy) greedy = generate_greedy_path(grid);
+            path_to_shared(greedy, &shared_data->paths[i], NULL);
+        } else {
+            seed_random(shared_data->base_seed,
+                        rng_stream_id(RNG_DOMAIN_INITIAL, 0, (uint32_t)i));
+            Path* path = generate_random_path(grid, random_int(20, MAX_PATH_LENGTH / 2));
+            path_to_shared(path, &shared_data->paths[i], NULL);
+            free_path(path);
+        }
+        evaluate_shared_path(shared_data, sem_id, i, grid, config);
+    }
+    
+    free_path(greedy);
+}
+
+// Replace a shared path by its locally searched version when that scores
+// higher
+static void improve_shared_path(SharedData* shared_data, int sem_id, int index,
+                                const Grid* grid, const Config* config) {
+    SharedPath* sp = &shared_data->paths[index];
+    Coordinate coordinates[MAX_PATH_LENGTH];
+    
+    Path temp_path;
+    temp_path.coordinates = coordinates;
+    temp_path.length = decode_path_moves(sp->start, shared_path_moves(sp), sp->encoded_bytes,
+                                         sp->length, coordinates);
+    temp_path.capacity = MAX_PATH_LENGTH;
+    temp_path.survivors_reached = sp->survivors_reached;
+    temp_path.survivors_visited = NULL;
+    temp_path.fitness = sp->fitness;
+    temp_path.collision_count = sp->collision_count;
+    temp_path.arena = NULL;
+    temp_path.body = NULL;
+    
+    // Workers cannot spill, and a cut path would not match its score: an
+    // improvement with too many escapes for the slot is dropped
+    Path* improved = memetic_improve_path(&temp_path, grid, config);
+    if (!improved) return;
+    if (encoded_prefix_length(improved->coordinates, improved->length, SHARED_MOVE_BYTES) <
+        improved->length) {
+        free_path(improved);
+        return;
+    }
+    
+    path_to_shared(improved, sp, NULL);
+    
+    sem_wait(sem_id, 0);
+    if (improved->fitness > shared_data->best_fitness) {
+        shared_data->best_fitness = improved->fitness;
+        shared_data->best_path_index = index;
+    }
+    sem_signal(sem_id, 0);
+    
+    free_path(improved);
+}
+
 void worker_process(int worker_id, int shm_id, int sem_id, 
-                   const Grid* grid, const Config* config) {
+                   Grid* grid, const Config* config) {
     
     SharedData* shared_data = (SharedData*)shmat(shm_id, NULL, 0);
     if (shared_data == (void*)-1) {
@@ -192,14 +335,19 @@ void worker_process(int worker_id, int shm_id, int sem_id,
     printf("Worker %d (PID: %d) started and ready\n", worker_id, getpid());
     fflush(stdout);
     
-    // Seed random with different value for each worker
-    srand(time(NULL) + getpid() + worker_id * 1000);
+    // Independent random stream per worker, derived from the master's seed
+    seed_random(shared_data->base_seed, rng_stream_id(RNG_DOMAIN_WORKER, 0, (uint32_t)worker_id));
+    
+    int deltas_applied = 0;
+    int last_batch = 0;
     
     while (1) {
         // Wait for work to be available
         sem_wait(sem_id, 0);
         int should_terminate = shared_data->termination_flag;
-        int work_ready = shared_data->work_ready;
+        int work_ready = shared_data->work_ready && shared_data->work_batch != last_batch;
+        int batch = shared_data->work_batch;
+        int task = shared_data->task;
         int my_start = shared_data->worker_ranges[worker_id].start_idx;
         int my_end = shared_data->worker_ranges[worker_id].end_idx;
         sem_signal(sem_id, 0);
@@ -213,37 +361,24 @@ void worker_process(int worker_id, int shm_id, int sem_id,
             continue;
         }
         
-        // DO THE ACTUAL WORK: Evaluate fitness for assigned paths
-        for (int i = my_start; i < my_end; i++) {
-            SharedPath* sp = &shared_data->paths[i];
-            
-            // Create temporary path structure
-            Path temp_path;
-            temp_path.coordinates = sp->coordinates;
-            temp_path.length = sp->length;
-            temp_path.capacity = MAX_PATH_LENGTH;
-            temp_path.survivors_reached = 0;
-            temp_path.survivors_visited = NULL;
-            temp_path.fitness = 0.0f;
-            temp_path.collision_count = 0;
-            
-            // Calculate fitness components
-            temp_path.survivors_reached = calculate_survivors_reached(&temp_path, grid);
-            temp_path.collision_count = check_path_collisions(&temp_path, grid);
-            temp_path.fitness = calculate_fitness(&temp_path, grid, config);
-            
-            // Update shared memory
-            sem_wait(sem_id, 0);
-            sp->survivors_reached = temp_path.survivors_reached;
-            sp->collision_count = temp_path.collision_count;
-            sp->fitness = temp_path.fitness;
-            
-            // Track best fitness
-            if (temp_path.fitness > shared_data->best_fitness) {
-                shared_data->best_fitness = temp_path.fitness;
-                shared_data->best_path_index = i;
+        // work_ready stays set until every worker is done; don't redo
+        // this batch when finishing early
+        last_batch = batch;
+        
+        // Bring our grid copy up to date with published collapse events
+        deltas_applied = sync_grid_deltas(shared_data, sem_id, grid, deltas_applied);
+        
+        // DO THE ACTUAL WORK
+        if (task == WORKER_TASK_GENERATE) {
+            generate_shared_paths(shared_data, sem_id, worker_id, grid, config);
+        } else if (task == WORKER_TASK_IMPROVE) {
+            for (int i = my_start; i < my_end; i++) {
+                improve_shared_path(shared_data, sem_id, i, grid, config);
+            }
+        } else {
+            for (int i = my_start; i < my_end; i++) {
+                evaluate_shared_path(shared_data, sem_id, i, grid, config);
             }
-            sem_signal(sem_id, 0);
         }
         
         // Signal completion
@@ -268,7 +403,7 @@ void worker_process(int worker_id, int shm_id, int sem_id,
 // ===== Process Pool Management =====
 
 pid_t* create_worker_pool(int num_workers, int shm_id, int sem_id,
-                          const Grid* grid, const Config* config) {
+                          Grid* grid, const Config* config) {
     pid_t* worker_pids = (pid_t*)safe_malloc(num_workers * sizeof(pid_t));
     
     for (int i = 0; i < num_workers; i++) {
@@ -306,6 +441,130 @@ void terminate_workers(pid_t* worker_pids, int num_workers) {
     free(worker_pids);
 }
 
+// ===== Grid Updates =====
+
+// Master: append an applied batch of deltas to the shared log
+void publish_grid_deltas(SharedData* shared_data, int sem_id, const Grid* grid,
+                         const CellDelta* deltas, int count) {
+    if (!shared_data || count <= 0) return;
+    
+    sem_wait(sem_id, 0);
+    for (int i = 0; i < count; i++) {
+        shared_data->delta_log[(shared_data->delta_total + i) % DELTA_LOG_SIZE] = deltas[i];
+        
+        int index = cell_index(grid, deltas[i].coord);
+        uint64_t bit = 1ULL << (index & 63);
+        shared_data->delta_touched[index >> 6] |= bit;
+        if (deltas[i].blocked) shared_data->delta_blocked[index >> 6] |= bit;
+        else shared_data->delta_blocked[index >> 6] &= ~bit;
+    }
+    shared_data->delta_total += count;
+    sem_signal(sem_id, 0);
+}
+
+// Every touched cell at its latest state; cells the worker already has
+// right are dropped by apply_obstacle_deltas. Call with the semaphore held.
+static CellDelta* collect_touched_cells(const SharedData* shared_data, const Grid* grid,
+                                        int* count) {
+    int words = (grid->total_cells + 63) / 64;
+    int touched = 0;
+    for (int w = 0; w < words; w++) {
+        touched += __builtin_popcountll(shared_data->delta_touched[w]);
+    }
+    
+    CellDelta* deltas = (CellDelta*)safe_malloc((touched > 0 ? touched : 1) * sizeof(CellDelta));
+    int n = 0;
+    for (int w = 0; w < words; w++) {
+        uint64_t bits = shared_data->delta_touched[w];
+        while (bits) {
+            int index = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            deltas[n].coord = cell_coordinate(grid, index);
+            deltas[n].blocked = (int)((shared_data->delta_blocked[w] >> (index & 63)) & 1);
+            n++;
+        }
+    }
+    *count = n;
+    return deltas;
+}
+
+// Worker: replay deltas published after 'applied'; returns the new position
+int sync_grid_deltas(SharedData* shared_data, int sem_id, Grid* grid, int applied) {
+    CellDelta* pending = NULL;
+    
+    sem_wait(sem_id, 0);
+    int total = shared_data->delta_total;
+    int count = total - applied;
+    if (count > DELTA_LOG_SIZE) {
+        // The ring has overwritten entries we never saw
+        pending = collect_touched_cells(shared_data, grid, &count);
+    } else if (count > 0) {
+        pending = (CellDelta*)safe_malloc(count * sizeof(CellDelta));
+        for (int i = 0; i < count; i++) {
+            pending[i] = shared_data->delta_log[(applied + i) % DELTA_LOG_SIZE];
+        }
+    }
+    sem_signal(sem_id, 0);
+    
+    if (count > 0) {
+        apply_obstacle_deltas(grid, pending, count);
+    }
+    free(pending);
+    return total;
+}
+
+// ===== Parallel Population Generation =====
+
+// Workers build and score the initial population straight into shared
+// memory; the master only copies the finished paths out
+Path** parallel_generate_population(const Config* config, SharedData* shared_data,
+                                    int sem_id, int* pop_size) {
+    int target_size = config->population_size;
+    
+    sem_wait(sem_id, 0);
+    shared_data->task = WORKER_TASK_GENERATE;
+    shared_data->population_size = target_size;
+    shared_data->greedy_count = initial_greedy_count(target_size);
+    distribute_work(shared_data, target_size, shared_data->num_workers);
+    sem_signal(sem_id, 0);
+    
+    wait_for_workers(shared_data, sem_id, shared_data->num_workers);
+    
+    Path** population = (Path**)safe_malloc(target_size * sizeof(Path*));
+    for (int i = 0; i < target_size; i++) {
+        population[i] = create_path(shared_data->paths[i].length);
+        shared_to_path(&shared_data->paths[i], population[i]);
+    }
+    
+    *pop_size = target_size;
+    return population;
+}
+
+// ===== Parallel Local Search =====
+
+// Local search on population[0..count) (the best paths once sorted);
+// returns how many were improved
+int parallel_improve_population(Path** population, int count,
+                                SharedData* shared_data, int sem_id) {
+    if (!population || !shared_data || count <= 0) return 0;
+    
+    copy_population_to_shared(population, count, shared_data);
+    
+    sem_wait(sem_id, 0);
+    shared_data->task = WORKER_TASK_IMPROVE;
+    distribute_work(shared_data, count, shared_data->num_workers);
+    sem_signal(sem_id, 0);
+    
+    wait_for_workers(shared_data, sem_id, shared_data->num_workers);
+    
+    int improved = 0;
+    for (int i = 0; i < count; i++) {
+        if (shared_data->paths[i].fitness > population[i]->fitness) improved++;
+    }
+    copy_population_from_shared(population, count, shared_data);
+    return improved;
+}
+
 // ===== Parallel Fitness Evaluation =====
 
 void parallel_evaluate_fitness(Path** population, int pop_size,
@@ -321,6 +580,7 @@ void parallel_evaluate_fitness(Path** population, int pop_size,
     
     // Distribute work to workers
     sem_wait(sem_id, 0);
+    shared_data->task = WORKER_TASK_EVALUATE;
     distribute_work(shared_data, pop_size, shared_data->num_workers);
     sem_signal(sem_id, 0);
     
@@ -328,7 +588,7 @@ void parallel_evaluate_fitness(Path** population, int pop_size,
     wait_for_workers(shared_data, sem_id, shared_data->num_workers);
     
     // Copy results back from shared memory
-    copy_population_from_shared(population, pop_size, shared_data);
+    copy_scores_from_shared(population, pop_size, shared_data);
 }
 
 // ===== Cleanup =====
@@ -5,16 +5,51 @@
 #include "path_generator.h"
 #include "grid_environment.h"
 #include "fitness.h"
+#include "local_search.h"
+#include "path_encoding.h"
 
 // ===== Shared Path Data for IPC =====
+// Paths travel as their start cell plus 3-bit moves (see path_encoding.h);
+// only the first 'encoded_bytes' of their moves are written or read.
+// Slots hold a path of unit moves with SHARED_INLINE_ESCAPES escapes to
+// spare (bred paths average about 10). Longer encodings written by the
+// master spill whole into SharedData's escape area, which is refilled
+// from the start every time the population is copied out.
+#define SHARED_INLINE_ESCAPES 16
+#define SHARED_MOVE_BYTES ((MAX_PATH_LENGTH * MOVE_BITS + SHARED_INLINE_ESCAPES * ESCAPE_BITS + 7) / 8)
+#define ESCAPE_AREA_BYTES (MAX_POPULATION / 8 * MAX_ENCODED_PATH_BYTES)
+
 typedef struct {
-    Coordinate coordinates[MAX_PATH_LENGTH];
+    Coordinate start;
     int length;
+    int encoded_bytes;
+    long spill_offset;              // 0 = moves inline, else bytes from this slot to them
     int survivors_reached;
     float fitness;
     int collision_count;
+    unsigned char moves[SHARED_MOVE_BYTES];
 } SharedPath;
 
+// The offset is relative, so it holds wherever a process maps the segment
+static inline const unsigned char* shared_path_moves(const SharedPath* sp) {
+    return sp->spill_offset ? (const unsigned char*)sp + sp->spill_offset : sp->moves;
+}
+
+// ===== Grid Delta Log =====
+// Collapse events published by the master; workers replay new entries on
+// their copy of the grid before evaluating. A worker the ring has lapped
+// (more than DELTA_LOG_SIZE deltas behind) resyncs instead from the cell
+// bitmaps, which hold the latest state of every cell a delta ever touched.
+#define DELTA_LOG_SIZE 4096
+#define DELTA_CELL_WORDS ((MAX_GRID_XY * MAX_GRID_XY * MAX_GRID_Z + 63) / 64)
+
+// ===== Worker Tasks =====
+typedef enum {
+    WORKER_TASK_EVALUATE = 0,       // Score the paths in the worker's range
+    WORKER_TASK_GENERATE = 1,       // Build and score initial paths (strided)
+    WORKER_TASK_IMPROVE = 2         // Local search on the paths in the range
+} WorkerTask;
+
 // ===== Worker Range Assignment =====
 typedef struct {
     int start_idx;
@@ -34,6 +69,10 @@ typedef struct {
     
     // Synchronization
     int work_ready;                 // Flag: 1 = work available
+    int work_batch;                 // Bumped per posting; a worker runs each batch once
+    int task;                       // WorkerTask for the posted work
+    int greedy_count;               // GENERATE: slots below this are greedy tours
+    unsigned long long base_seed;   // Worker RNG streams are derived from this
     int workers_completed;          // Count of workers finished
     int current_generation;
     
@@ -43,6 +82,16 @@ typedef struct {
     
     // Termination
     int termination_flag;
+    
+    // Grid updates
+    CellDelta delta_log[DELTA_LOG_SIZE];
+    int delta_total;                // Deltas published since start
+    uint64_t delta_touched[DELTA_CELL_WORDS];  // Cells any delta changed
+    uint64_t delta_blocked[DELTA_CELL_WORDS];  // Their latest state
+    
+    // Spilled path moves (master writes only)
+    int escape_used;
+    unsigned char escape_area[ESCAPE_AREA_BYTES];
 } SharedData;
 
 // ===== IPC Setup =====
@@ -55,14 +104,18 @@ void sem_wait(int sem_id, int sem_num);
 void sem_signal(int sem_id, int sem_num);
 
 // ===== Path Transfer Functions =====
-void path_to_shared(const Path* path, SharedPath* shared_path);
+// Returns the cells stored: a path is cut to MAX_PATH_LENGTH, and to what
+// fits when neither the slot nor the escape area of 'spill' (NULL = slot
+// only) has room, so its score must come from the stored cells
+int path_to_shared(const Path* path, SharedPath* shared_path, SharedData* spill);
 void shared_to_path(const SharedPath* shared_path, Path* path);
 void copy_population_to_shared(Path** population, int pop_size, SharedData* shared_data);
 void copy_population_from_shared(Path** population, int pop_size, SharedData* shared_data);
+void copy_scores_from_shared(Path** population, int pop_size, const SharedData* shared_data);
 
 // ===== Worker Process =====
 void worker_process(int worker_id, int shm_id, int sem_id, 
-                   const Grid* grid, const Config* config);
+                   Grid* grid, const Config* config);
 
 // ===== Work Distribution =====
 void distribute_work(SharedData* shared_data, int pop_size, int num_workers);
@@ -70,9 +123,22 @@ void wait_for_workers(SharedData* shared_data, int sem_id, int num_workers);
 
 // ===== Process Pool Management =====
 pid_t* create_worker_pool(int num_workers, int shm_id, int sem_id,
-                          const Grid* grid, const Config* config);
+                          Grid* grid, const Config* config);
 void terminate_workers(pid_t* worker_pids, int num_workers);
 
+// ===== Grid Updates =====
+void publish_grid_deltas(SharedData* shared_data, int sem_id, const Grid* grid,
+                         const CellDelta* deltas, int count);
+int sync_grid_deltas(SharedData* shared_data, int sem_id, Grid* grid, int applied);
+
+// ===== Parallel Population Generation =====
+Path** parallel_generate_population(const Config* config, SharedData* shared_data,
+                                    int sem_id, int* pop_size);
+
+// ===== Parallel Local Search =====
+int parallel_improve_population(Path** population, int count,
+                                SharedData* shared_data, int sem_id);
+
 // ===== Parallel Fitness Evaluation =====
 void parallel_evaluate_fitness(Path** population, int pop_size,
                               const Grid* grid, const Config* config,
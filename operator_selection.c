@@ -0,0 +1,199 @@
+#include "operator_selection.h"
+
+static const char* crossover_names[NUM_CROSSOVER_OPERATORS] = {
+    "Single_Point", "Two_Point", "Uniform"
+};
+static const char* mutation_names[NUM_MUTATION_OPERATORS] = {
+    "Insert", "Swap", "Remove_Loop", "Reverse"
+};
+
+// What bred one child of the generation in progress
+typedef struct {
+    signed char crossover;
+    signed char mutation;
+    float parent_fitness;
+} OperatorRecord;
+
+typedef struct {
+    int adaptive;
+    OperatorBandit crossover;
+    OperatorBandit mutation;
+    OperatorRecord* records;
+    int record_count;
+    int record_capacity;
+} OperatorSelector;
+
+static OperatorSelector selector = {0};
+
+// ===== Setup =====
+
+static void reset_bandit(OperatorBandit* bandit, int count) {
+    memset(bandit, 0, sizeof(OperatorBandit));
+    bandit->count = count;
+    for (int i = 0; i < count; i++) {
+        bandit->arms[i].probability = 1.0f / count;
+    }
+}
+
+void configure_operator_selection(const Config* config) {
+    selector.adaptive = config->adaptive_operators;
+    reset_bandit(&selector.crossover, NUM_CROSSOVER_OPERATORS);
+    reset_bandit(&selector.mutation, NUM_MUTATION_OPERATORS);
+    selector.record_count = 0;
+}
+
+void free_operator_selection(void) {
+    free(selector.records);
+    selector.records = NULL;
+    selector.record_count = 0;
+    selector.record_capacity = 0;
+}
+
+// ===== Selection =====
+
+static int draw_arm(const OperatorBandit* bandit) {
+    float r = random_float(0.0f, 1.0f);
+    for (int i = 0; i < bandit->count - 1; i++) {
+        r -= bandit->arms[i].probability;
+        if (r < 0.0f) return i;
+    }
+    return bandit->count - 1;
+}
+
+int select_crossover_operator(void) {
+    return draw_arm(&selector.crossover);
+}
+
+int select_mutation_operator(void) {
+    return draw_arm(&selector.mutation);
+}
+
+// ===== Credit Assignment =====
+
+void begin_operator_records(int pop_size) {
+    if (pop_size > selector.record_capacity) {
+        selector.record_capacity = pop_size;
+        selector.records = (OperatorRecord*)realloc(selector.records,
+                                                    pop_size * sizeof(OperatorRecord));
+        if (!selector.records) {
+            error_exit("Failed to allocate operator records");
+        }
+    }
+    selector.record_count = pop_size;
+    for (int i = 0; i < pop_size; i++) {
+        selector.records[i].crossover = OPERATOR_NONE;
+        selector.records[i].mutation = OPERATOR_NONE;
+        selector.records[i].parent_fitness = 0.0f;
+    }
+}
+
+void record_operators(int slot, int crossover, double crossover_cost,
+                      int mutation, double mutation_cost, float parent_fitness) {
+    if (slot < 0 || slot >= selector.record_count) return;
+
+    OperatorRecord* record = &selector.records[slot];
+    record->crossover = (signed char)crossover;
+    record->mutation = (signed char)mutation;
+    record->parent_fitness = parent_fitness;
+
+    if (crossover != OPERATOR_NONE) {
+        OperatorArm* arm = &selector.crossover.arms[crossover];
+        arm->cost += crossover_cost;
+        arm->uses++;
+        arm->total_uses++;
+    }
+    if (mutation != OPERATOR_NONE) {
+        OperatorArm* arm = &selector.mutation.arms[mutation];
+        arm->cost += mutation_cost;
+        arm->uses++;
+        arm->total_uses++;
+    }
+}
+
+// Fold this generation's gain per unit of work into each arm's quality and
+// re-derive the selection probabilities. Arms not used this generation
+// keep their quality. A use is charged at least one unit, so near-free
+// operators on tiny paths do not dominate.
+static void update_bandit(OperatorBandit* bandit, int adaptive) {
+    double total_quality = 0.0;
+    for (int i = 0; i < bandit->count; i++) {
+        OperatorArm* arm = &bandit->arms[i];
+        if (arm->uses > 0) {
+            double cost = arm->cost > arm->uses ? arm->cost : arm->uses;
+            double rate = arm->gain / cost;
+            arm->quality += OPERATOR_QUALITY_DECAY * (rate - arm->quality);
+        }
+        total_quality += arm->quality;
+        arm->gain = 0.0;
+        arm->cost = 0.0;
+        arm->uses = 0;
+    }
+
+    if (!adaptive) return;
+
+    float spread = 1.0f - bandit->count * OPERATOR_MIN_PROBABILITY;
+    for (int i = 0; i < bandit->count; i++) {
+        OperatorArm* arm = &bandit->arms[i];
+        arm->probability = total_quality > 0.0
+            ? OPERATOR_MIN_PROBABILITY + spread * (float)(arm->quality / total_quality)
+            : 1.0f / bandit->count;
+    }
+}
+
+void credit_operators(Path** population, int pop_size) {
+    if (!population) return;
+
+    int count = pop_size < selector.record_count ? pop_size : selector.record_count;
+    for (int i = 0; i < count; i++) {
+        const OperatorRecord* record = &selector.records[i];
+        float gain = population[i]->fitness - record->parent_fitness;
+        if (gain <= 0.0f) continue;
+
+        if (record->crossover != OPERATOR_NONE) {
+            selector.crossover.arms[(int)record->crossover].gain += gain;
+        }
+        if (record->mutation != OPERATOR_NONE) {
+            selector.mutation.arms[(int)record->mutation].gain += gain;
+        }
+    }
+    selector.record_count = 0;
+
+    update_bandit(&selector.crossover, selector.adaptive);
+    update_bandit(&selector.mutation, selector.adaptive);
+}
+
+// ===== Reporting =====
+
+void write_operator_mix_header(FILE* file) {
+    for (int i = 0; i < NUM_CROSSOVER_OPERATORS; i++) {
+        fprintf(file, ",P_%s", crossover_names[i]);
+    }
+    for (int i = 0; i < NUM_MUTATION_OPERATORS; i++) {
+        fprintf(file, ",P_%s", mutation_names[i]);
+    }
+}
+
+void write_operator_mix(FILE* file) {
+    for (int i = 0; i < selector.crossover.count; i++) {
+        fprintf(file, ",%.3f", selector.crossover.arms[i].probability);
+    }
+    for (int i = 0; i < selector.mutation.count; i++) {
+        fprintf(file, ",%.3f", selector.mutation.arms[i].probability);
+    }
+}
+
+static void print_bandit(const char* title, const OperatorBandit* bandit,
+                         const char** names) {
+    printf("  %s:\n", title);
+    for (int i = 0; i < bandit->count; i++) {
+        const OperatorArm* arm = &bandit->arms[i];
+        printf("    %-12s p=%.3f  uses=%lld  gain/work=%.3g\n", names[i],
+               arm->probability, arm->total_uses, arm->quality);
+    }
+}
+
+void print_operator_stats(void) {
+    printf("\nOperator Selection (%s):\n", selector.adaptive ? "adaptive" : "uniform");
+    print_bandit("Crossover", &selector.crossover, crossover_names);
+    print_bandit("Mutation", &selector.mutation, mutation_names);
+}
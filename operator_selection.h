@@ -0,0 +1,78 @@
+#ifndef OPERATOR_SELECTION_H
+#define OPERATOR_SELECTION_H
+
+#include <stdio.h>
+#include "utilities.h"
+#include "path_generator.h"
+
+// ===== Adaptive Operator Selection =====
+// Cost-aware probability matching over the crossover and mutation
+// operators. While breeding, each child records the operators that made
+// it, the work they did and its better parent's fitness. Once the
+// generation is evaluated, every arm is credited with its children's
+// fitness gain over that parent, and its quality becomes a decayed average
+// of gain per unit of work. Operators are then drawn in proportion to
+// quality, with a floor of OPERATOR_MIN_PROBABILITY so that no arm stops
+// being tried.
+//
+// Work is a deterministic stand-in for time: search nodes expanded while
+// repairing the child plus the cells it ends up with. Crossover and
+// mutation on the same child share its gain. Adaptive selection is the
+// default and replays exactly under a fixed SEED;
+// OPERATOR_SELECTION=uniform draws every operator with equal probability.
+
+typedef enum {
+    CROSSOVER_SINGLE_POINT = 0,
+    CROSSOVER_TWO_POINT = 1,
+    CROSSOVER_UNIFORM = 2,
+    NUM_CROSSOVER_OPERATORS
+} CrossoverOperator;
+
+typedef enum {
+    MUTATION_INSERT = 0,
+    MUTATION_SWAP = 1,
+    MUTATION_REMOVE_LOOP = 2,
+    MUTATION_REVERSE = 3,
+    NUM_MUTATION_OPERATORS
+} MutationOperator;
+
+#define OPERATOR_NONE -1
+#define MAX_OPERATOR_ARMS 4
+#define OPERATOR_MIN_PROBABILITY 0.05f
+#define OPERATOR_QUALITY_DECAY 0.3      // Weight of the newest generation
+
+typedef struct {
+    double gain;             // Fitness gained by this generation's children
+    double cost;             // Work done this generation
+    int uses;                // Children this generation
+    long long total_uses;
+    double quality;          // Decayed gain per unit of work
+    float probability;
+} OperatorArm;
+
+typedef struct {
+    int count;
+    OperatorArm arms[MAX_OPERATOR_ARMS];
+} OperatorBandit;
+
+// ===== Setup =====
+void configure_operator_selection(const Config* config);
+void free_operator_selection(void);
+
+// ===== Breeding =====
+int select_crossover_operator(void);
+int select_mutation_operator(void);
+// Slots are next-generation indices; unrecorded slots (elites) earn nothing
+void begin_operator_records(int pop_size);
+void record_operators(int slot, int crossover, double crossover_cost,
+                      int mutation, double mutation_cost, float parent_fitness);
+// Call once the children are scored and before they are reordered
+void credit_operators(Path** population, int pop_size);
+
+// ===== Reporting =====
+// Extra stats CSV columns: the current selection probabilities
+void write_operator_mix_header(FILE* file);
+void write_operator_mix(FILE* file);
+void print_operator_stats(void);
+
+#endif // OPERATOR_SELECTION_H
@@ -0,0 +1,109 @@
+#include "path_arena.h"
+
+#define ARENA_ALIGNMENT 16
+
+static _Thread_local PathArena* thread_active_arena = NULL;
+
+// ===== Arena Creation and Destruction =====
+
+PathArena* create_path_arena(size_t capacity) {
+    PathArena* arena = (PathArena*)safe_calloc(1, sizeof(PathArena));
+    arena->capacity = capacity > 0 ? capacity : 4096;
+    arena->block = (unsigned char*)safe_malloc(arena->capacity);
+    return arena;
+}
+
+static void free_overflow_blocks(PathArena* arena) {
+    for (int i = 0; i < arena->overflow_count; i++) {
+        free(arena->overflow[i]);
+    }
+    arena->overflow_count = 0;
+    arena->overflow_bytes = 0;
+}
+
+static void release_bodies(PathArena* arena) {
+    for (int i = 0; i < arena->body_count; i++) {
+        release_path_body(arena->bodies[i]);
+    }
+    arena->body_count = 0;
+}
+
+void free_path_arena(PathArena* arena) {
+    if (!arena) return;
+    if (thread_active_arena == arena) thread_active_arena = NULL;
+    release_bodies(arena);
+    free(arena->bodies);
+    free_overflow_blocks(arena);
+    free(arena->overflow);
+    free(arena->block);
+    free(arena);
+}
+
+// ===== Allocation =====
+
+void* path_arena_alloc(PathArena* arena, size_t bytes) {
+    bytes = (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    if (arena->used + bytes <= arena->capacity) {
+        void* memory = arena->block + arena->used;
+        arena->used += bytes;
+        return memory;
+    }
+
+    if (arena->overflow_count >= arena->overflow_capacity) {
+        arena->overflow_capacity = arena->overflow_capacity ? arena->overflow_capacity * 2 : 16;
+        arena->overflow = (unsigned char**)realloc(arena->overflow,
+                                                   arena->overflow_capacity * sizeof(unsigned char*));
+        if (!arena->overflow) {
+            error_exit("Failed to grow path arena");
+        }
+    }
+    unsigned char* memory = (unsigned char*)safe_malloc(bytes);
+    arena->overflow[arena->overflow_count++] = memory;
+    arena->overflow_bytes += bytes;
+    return memory;
+}
+
+// The caller has already taken a reference for the path
+void path_arena_retain_body(PathArena* arena, PathBody* body) {
+    if (arena->body_count >= arena->body_capacity) {
+        arena->body_capacity = arena->body_capacity ? arena->body_capacity * 2 : 64;
+        arena->bodies = (PathBody**)realloc(arena->bodies,
+                                            arena->body_capacity * sizeof(PathBody*));
+        if (!arena->bodies) {
+            error_exit("Failed to grow path arena");
+        }
+    }
+    arena->bodies[arena->body_count++] = body;
+}
+
+// Everything allocated from the arena becomes invalid
+void reset_path_arena(PathArena* arena) {
+    release_bodies(arena);
+
+    size_t in_use = arena->used + arena->overflow_bytes;
+    if (in_use > arena->peak) arena->peak = in_use;
+
+    if (arena->overflow_count > 0) {
+        // Make room for the whole of this generation, plus some slack
+        size_t capacity = in_use + in_use / 4;
+        free_overflow_blocks(arena);
+        free(arena->block);
+        arena->block = (unsigned char*)safe_malloc(capacity);
+        arena->capacity = capacity;
+    }
+    arena->used = 0;
+    arena->resets++;
+}
+
+// ===== Active Arena =====
+
+PathArena* set_active_path_arena(PathArena* arena) {
+    PathArena* previous = thread_active_arena;
+    thread_active_arena = arena;
+    return previous;
+}
+
+PathArena* active_path_arena(void) {
+    return thread_active_arena;
+}
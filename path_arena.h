@@ -0,0 +1,48 @@
+#ifndef PATH_ARENA_H
+#define PATH_ARENA_H
+
+#include "utilities.h"
+#include "path_generator.h"
+
+// ===== Generation Arenas =====
+// Bump allocator for the Path structs and coordinate buffers of one
+// generation. The GA keeps two: children are allocated from the next
+// generation's arena, and once the old population is dropped its arena is
+// reset in O(1). free_path() is a no-op on arena paths, and growing one
+// takes a fresh buffer from the same arena.
+//
+// A request that does not fit goes to an overflow block; the next reset
+// frees those and enlarges the main block once, so after the first few
+// generations the loop does no malloc at all.
+//
+// Shared path bodies (share_path) are on the heap, since they outlive a
+// generation; the arena holds its paths' references and drops them on
+// reset.
+
+typedef struct PathArena {
+    unsigned char* block;
+    size_t capacity;
+    size_t used;
+    unsigned char** overflow;    // Blocks handed out since the last reset
+    int overflow_count;
+    int overflow_capacity;
+    size_t overflow_bytes;
+    size_t peak;                 // Most bytes in use before a reset
+    int resets;
+    PathBody** bodies;           // Body references held by this arena's paths
+    int body_count;
+    int body_capacity;
+} PathArena;
+
+PathArena* create_path_arena(size_t capacity);
+void free_path_arena(PathArena* arena);
+void* path_arena_alloc(PathArena* arena, size_t bytes);
+void reset_path_arena(PathArena* arena);
+void path_arena_retain_body(PathArena* arena, PathBody* body);
+
+// Paths created while an arena is active (create_path, clone_path) come
+// from it; returns the previously active arena so calls can nest
+PathArena* set_active_path_arena(PathArena* arena);
+PathArena* active_path_arena(void);
+
+#endif // PATH_ARENA_H
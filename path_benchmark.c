@@ -0,0 +1,253 @@
+#include "dstar_lite.h"
+#include "grid_environment.h"
+#include "jump_point_search.h"
+#include "path_generator.h"
+#include "landmarks.h"
+#include "path_hierarchy.h"
+#include "utilities.h"
+#include "voxel_import.h"
+
+// ===== Pathfinding Benchmark =====
+// Runs the same random start/goal pairs through every search variant on
+// each given config's grid and reports node expansions, time and total
+// path length, then replays a robot walk with cells collapsing ahead of it
+// to compare incremental replanning against searching from scratch.
+// Usage: rescue_bench [-q queries] [-g XxYxZ] config1.txt [config2.txt ...]
+// (-g overrides every config's grid size, e.g. -g 200x200x10)
+
+#define DEFAULT_QUERIES 500
+#define BENCH_SEED 0x5EEDULL
+#define REPLAN_STEPS 4           // Cells walked between collapses
+#define MAX_REPLANS 500
+
+typedef Path* (*SearchFunction)(const Grid* grid, Coordinate start, Coordinate goal,
+                                SearchContext* ctx);
+
+typedef struct {
+    const char* name;
+    int astar_queue;             // Open list used by A*-based variants
+    int landmarks;               // Use the config's ALT landmarks
+    SearchFunction search;
+} SearchVariant;
+
+static const SearchVariant variants[] = {
+    {"A* (heap)",     0, 0, find_path_astar},
+    {"A* (bucket)",   1, 0, find_path_astar},
+    {"A* ALT (heap)", 0, 1, find_path_astar},
+    {"A* ALT (bkt)",  1, 1, find_path_astar},
+    {"JPS",           0, 0, find_path_jps},
+    {"Bidirectional", 0, 0, find_path_bidirectional},
+    {"Bidir ALT",     0, 1, find_path_bidirectional},
+    {"HPA*",          0, 0, find_path_hpa},
+};
+#define NUM_VARIANTS ((int)(sizeof(variants) / sizeof(variants[0])))
+
+static Grid* build_bench_grid(Config* config) {
+    if (config->voxel_file[0] != '\0') {
+        VoxelImportOptions options = voxel_options_from_config(config);
+        return import_voxel_grid(config->voxel_file, config->survivor_file, &options);
+    }
+
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+    return grid;
+}
+
+// Random walkable pairs in the same component, identical for every variant
+static int pick_queries(const Grid* grid, int count, Coordinate* from, Coordinate* to) {
+    Rng rng;
+    rng_seed(&rng, BENCH_SEED);
+
+    int picked = 0;
+    int attempts = 0;
+    while (picked < count && attempts < count * 100) {
+        attempts++;
+        Coordinate a = cell_coordinate(grid, (int)rng_range(&rng, (uint32_t)grid->total_cells));
+        Coordinate b = cell_coordinate(grid, (int)rng_range(&rng, (uint32_t)grid->total_cells));
+        if (is_obstacle(grid, a) || is_obstacle(grid, b)) continue;
+        if (!cells_connected(grid, a, b)) continue;
+        from[picked] = a;
+        to[picked] = b;
+        picked++;
+    }
+    return picked;
+}
+
+// The robot follows its route REPLAN_STEPS cells at a time; after each
+// move a cell just ahead of it collapses and the route is repaired. The
+// grid is modified, so this runs last.
+static void bench_replanning(Grid* grid, SearchContext* ctx) {
+    Replanner* planner = create_replanner(grid);
+    Rng rng;
+    rng_seed(&rng, BENCH_SEED);
+
+    uint64_t targets = 0;
+    for (int s = 0; s < grid->num_survivors && s < 64; s++) {
+        if (cells_connected(grid, grid->start, grid->survivors[s])) targets |= 1ULL << s;
+    }
+
+    Coordinate robot = grid->start;
+    double dstar_ms = 0.0;
+    double scratch_ms = 0.0;
+    long long scratch_expansions = 0;
+    int replans = 0;
+    int collapses = 0;
+    int mismatches = 0;
+
+    while (targets && replans < MAX_REPLANS) {
+        int found = -1;
+        double t = get_time_ms();
+        Path* path = replan_path(planner, grid, robot, targets, &found);
+        dstar_ms += get_time_ms() - t;
+
+        long long before = ctx->expansions;
+        t = get_time_ms();
+        Path* reference = find_path_to_any_survivor(grid, robot, targets, ctx, NULL);
+        scratch_ms += get_time_ms() - t;
+        scratch_expansions += ctx->expansions - before;
+
+        replans++;
+        int length = path ? path->length : 0;
+        if (length != (reference ? reference->length : 0)) mismatches++;
+        free_path(reference);
+
+        if (!path) break;
+        if (length - 1 <= REPLAN_STEPS) {
+            robot = path->coordinates[length - 1];
+            targets &= ~(1ULL << found);
+        } else {
+            robot = path->coordinates[REPLAN_STEPS];
+            int ahead = REPLAN_STEPS + 1 + (int)rng_range(&rng, 3);
+            if (ahead < length) {
+                CellDelta delta = {path->coordinates[ahead], 1};
+                int kept = apply_obstacle_deltas(grid, &delta, 1);
+                replanner_notify_deltas(planner, grid, &delta, kept);
+                collapses += kept;
+            }
+        }
+        free_path(path);
+    }
+
+    printf("  Replanning: %d replans, %d collapses ahead of the robot, %d length mismatches\n",
+           replans, collapses, mismatches);
+    printf("  %-14s %14lld %12.1f %10.2f\n", "D* Lite",
+           replanner_expansions(planner),
+           replans > 0 ? (double)replanner_expansions(planner) / replans : 0.0, dstar_ms);
+    printf("  %-14s %14lld %12.1f %10.2f\n", "From scratch", scratch_expansions,
+           replans > 0 ? (double)scratch_expansions / replans : 0.0, scratch_ms);
+
+    free_replanner(planner);
+}
+
+static void bench_config(const char* filename, int queries, const int* grid_size) {
+    Config* config = load_config(filename);
+    if (grid_size[0] > 0) {
+        config->grid_x = grid_size[0];
+        config->grid_y = grid_size[1];
+        config->grid_z = grid_size[2];
+    }
+    if (!validate_config(config)) {
+        fprintf(stderr, "Skipping invalid config: %s\n", filename);
+        free_config(config);
+        return;
+    }
+
+    Grid* grid = build_bench_grid(config);
+    if (!grid) {
+        free_config(config);
+        return;
+    }
+
+    Coordinate* from = (Coordinate*)safe_malloc(queries * sizeof(Coordinate));
+    Coordinate* to = (Coordinate*)safe_malloc(queries * sizeof(Coordinate));
+    int count = pick_queries(grid, queries, from, to);
+
+    printf("\n%s: %dx%dx%d, %d obstacles, %d queries\n", filename,
+           grid->size_x, grid->size_y, grid->size_z, grid->obstacle_count, count);
+
+    int landmark_count = config->landmark_count > 0 ? config->landmark_count : 8;
+    config->landmark_count = landmark_count;
+    configure_pathfinding(config);
+    double build_start = get_time_ms();
+    const PathHierarchy* hierarchy = get_path_hierarchy(grid);
+    printf("  (hierarchy: %d nodes, %d edges, built in %.1f ms)\n",
+           hierarchy->num_nodes, hierarchy->num_edges, get_time_ms() - build_start);
+    build_start = get_time_ms();
+    get_landmark_table(grid);
+    printf("  (%d landmarks: %.1f KB, built in %.1f ms)\n", landmark_count,
+           grid->total_cells * landmark_count * sizeof(uint16_t) / 1024.0,
+           get_time_ms() - build_start);
+
+    printf("  %-14s %14s %12s %10s %12s %9s\n",
+           "Variant", "Expansions", "Exp/query", "Time ms", "Total steps", "Mismatch");
+    SearchContext* ctx = create_search_context(grid);
+    int* reference = (int*)safe_malloc(count * sizeof(int));
+
+    for (int v = 0; v < NUM_VARIANTS; v++) {
+        config->astar_queue = variants[v].astar_queue;
+        config->landmark_count = variants[v].landmarks ? landmark_count : 0;
+        configure_pathfinding(config);
+
+        long long expansions_before = ctx->expansions;
+        long long total_steps = 0;
+        int mismatches = 0;
+        double start_time = get_time_ms();
+
+        for (int q = 0; q < count; q++) {
+            Path* path = variants[v].search(grid, from[q], to[q], ctx);
+            int steps = path ? path->length - 1 : -1;
+
+            if (v == 0) reference[q] = steps;
+            else if (steps != reference[q]) mismatches++;
+
+            if (steps > 0) total_steps += steps;
+            free_path(path);
+        }
+
+        double elapsed = get_time_ms() - start_time;
+        long long expansions = ctx->expansions - expansions_before;
+        printf("  %-14s %14lld %12.1f %10.2f %12lld %9d\n", variants[v].name,
+               expansions, count > 0 ? (double)expansions / count : 0.0,
+               elapsed, total_steps, mismatches);
+    }
+
+    free(reference);
+    bench_replanning(grid, ctx);
+    free_search_context(ctx);
+    free(from);
+    free(to);
+    free_grid(grid);
+    free_config(config);
+}
+
+int main(int argc, char* argv[]) {
+    int queries = DEFAULT_QUERIES;
+    int grid_size[3] = {0, 0, 0};
+    int first_config = 1;
+    int valid = 1;
+
+    while (valid && first_config + 1 < argc && argv[first_config][0] == '-') {
+        const char* option = argv[first_config];
+        const char* value = argv[first_config + 1];
+        if (strcmp(option, "-q") == 0) {
+            queries = atoi(value);
+        } else if (strcmp(option, "-g") == 0) {
+            valid = sscanf(value, "%dx%dx%d", &grid_size[0], &grid_size[1], &grid_size[2]) == 3 &&
+                    grid_size[0] > 0 && grid_size[1] > 0 && grid_size[2] > 0;
+        } else {
+            valid = 0;
+        }
+        first_config += 2;
+    }
+    if (!valid || queries <= 0 || first_config >= argc) {
+        fprintf(stderr, "Usage: %s [-q queries] [-g XxYxZ] config.txt [more configs...]\n", argv[0]);
+        return 1;
+    }
+
+    printf("========== Pathfinding Benchmark ==========\n");
+    for (int i = first_config; i < argc; i++) {
+        bench_config(argv[i], queries, grid_size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include "path_encoding.h"
+
+// ===== Bit Streams =====
+
+typedef struct {
+    unsigned char* data;
+    int capacity;            // Bytes
+    long bit;                // Next bit to write
+} BitWriter;
+
+typedef struct {
+    const unsigned char* data;
+    long total_bits;
+    long bit;
+} BitReader;
+
+static int write_bits(BitWriter* writer, uint64_t value, int count) {
+    if (writer->bit + count > (long)writer->capacity * 8) return 0;
+
+    for (int i = 0; i < count; i++, writer->bit++) {
+        unsigned char mask = (unsigned char)(1u << (writer->bit & 7));
+        if ((value >> i) & 1) writer->data[writer->bit >> 3] |= mask;
+        else writer->data[writer->bit >> 3] &= (unsigned char)~mask;
+    }
+    return 1;
+}
+
+static int read_bits(BitReader* reader, int count, uint64_t* value) {
+    if (reader->bit + count > reader->total_bits) return 0;
+
+    *value = 0;
+    for (int i = 0; i < count; i++, reader->bit++) {
+        if (reader->data[reader->bit >> 3] & (1u << (reader->bit & 7))) {
+            *value |= 1ULL << i;
+        }
+    }
+    return 1;
+}
+
+// ===== Encode / Decode =====
+
+static int move_code(Coordinate from, Coordinate to) {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    int dz = to.z - from.z;
+
+    if (dx == 0 && dy == 0 && dz == 0) return MOVE_STAY;
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (dx == DIR_DX[d] && dy == DIR_DY[d] && dz == DIR_DZ[d]) return d;
+    }
+    return MOVE_ESCAPE;
+}
+
+static inline int fits_int16(Coordinate c) {
+    return c.x >= INT16_MIN && c.x <= MAX_ENCODED_COORDINATE &&
+           c.y >= INT16_MIN && c.y <= MAX_ENCODED_COORDINATE &&
+           c.z >= INT16_MIN && c.z <= MAX_ENCODED_COORDINATE;
+}
+
+int encode_path_moves(const Coordinate* coordinates, int length,
+                      unsigned char* out, int capacity) {
+    BitWriter writer = {out, capacity, 0};
+
+    for (int i = 1; i < length; i++) {
+        int code = move_code(coordinates[i - 1], coordinates[i]);
+        if (!write_bits(&writer, (uint64_t)code, MOVE_BITS)) return -1;
+
+        if (code == MOVE_ESCAPE) {
+            Coordinate c = coordinates[i];
+            if (!fits_int16(c)) return -1;
+            uint64_t packed = (uint64_t)(uint16_t)c.x |
+                              (uint64_t)(uint16_t)c.y << 16 |
+                              (uint64_t)(uint16_t)c.z << 32;
+            if (!write_bits(&writer, packed, ESCAPE_BITS)) return -1;
+        }
+    }
+    return (int)((writer.bit + 7) / 8);
+}
+
+int encoded_prefix_length(const Coordinate* coordinates, int length, int capacity) {
+    long available = (long)capacity * 8;
+    long bits = 0;
+
+    for (int i = 1; i < length; i++) {
+        int code = move_code(coordinates[i - 1], coordinates[i]);
+        bits += MOVE_BITS + (code == MOVE_ESCAPE ? ESCAPE_BITS : 0);
+        if (bits > available) return i;
+        if (code == MOVE_ESCAPE && !fits_int16(coordinates[i])) return -1;
+    }
+    return length;
+}
+
+int decode_path_moves(Coordinate start, const unsigned char* moves, int bytes,
+                      int length, Coordinate* out) {
+    if (length <= 0) return 0;
+
+    BitReader reader = {moves, (long)bytes * 8, 0};
+    out[0] = start;
+
+    for (int i = 1; i < length; i++) {
+        uint64_t code;
+        if (!read_bits(&reader, MOVE_BITS, &code)) return i;
+
+        Coordinate previous = out[i - 1];
+        if (code < NUM_DIRECTIONS) {
+            out[i] = create_coordinate(previous.x + DIR_DX[code], previous.y + DIR_DY[code],
+                                       previous.z + DIR_DZ[code]);
+        } else if (code == MOVE_STAY) {
+            out[i] = previous;
+        } else {
+            uint64_t packed;
+            if (!read_bits(&reader, ESCAPE_BITS, &packed)) return i;
+            out[i] = create_coordinate((int16_t)(packed & 0xFFFF),
+                                       (int16_t)((packed >> 16) & 0xFFFF),
+                                       (int16_t)((packed >> 32) & 0xFFFF));
+        }
+    }
+    return length;
+}
+
+int decode_path_cells(const Grid* grid, Coordinate start, const unsigned char* moves,
+                      int bytes, int length, CellId* out) {
+    if (length <= 0) return 0;
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    BitReader reader = {moves, (long)bytes * 8, 0};
+    Coordinate current = start;
+    out[0] = cell_id(grid, start);
+
+    for (int i = 1; i < length; i++) {
+        uint64_t code;
+        if (!read_bits(&reader, MOVE_BITS, &code)) return i;
+
+        if (code < NUM_DIRECTIONS) {
+            current.x += DIR_DX[code];
+            current.y += DIR_DY[code];
+            current.z += DIR_DZ[code];
+            // Stepping off the grid (or back on) has no offset form
+            out[i] = out[i - 1] != CELL_ID_NONE && is_valid_coordinate(grid, current)
+                ? out[i - 1] + (CellId)offsets[code] : cell_id(grid, current);
+        } else if (code == MOVE_STAY) {
+            out[i] = out[i - 1];
+        } else {
+            uint64_t packed;
+            if (!read_bits(&reader, ESCAPE_BITS, &packed)) return i;
+            current = create_coordinate((int16_t)(packed & 0xFFFF),
+                                        (int16_t)((packed >> 16) & 0xFFFF),
+                                        (int16_t)((packed >> 32) & 0xFFFF));
+            out[i] = cell_id(grid, current);
+        }
+    }
+    return length;
+}
+
+// ===== Encoded Path Files =====
+
+static const char ENCODED_MAGIC[4] = {'R', 'P', 'M', '1'};
+
+int save_encoded_path(const Path* path, const char* filename) {
+    int capacity = (path->length * (MOVE_BITS + ESCAPE_BITS) + 7) / 8 + 1;
+    unsigned char* moves = (unsigned char*)safe_calloc(capacity, 1);
+    int bytes = path->length > 0
+        ? encode_path_moves(path->coordinates, path->length, moves, capacity) : 0;
+
+    Coordinate start = path->length > 0 ? path->coordinates[0] : create_coordinate(0, 0, 0);
+    if (bytes < 0 || !fits_int16(start)) {
+        warning("Path coordinates exceed the int16 range of the move encoding");
+        free(moves);
+        return 0;
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        warning("Could not save encoded path");
+        free(moves);
+        return 0;
+    }
+
+    int16_t header[3] = {(int16_t)start.x, (int16_t)start.y, (int16_t)start.z};
+    int32_t counts[2] = {path->length, bytes};
+
+    fwrite(ENCODED_MAGIC, 1, sizeof(ENCODED_MAGIC), file);
+    fwrite(header, sizeof(int16_t), 3, file);
+    fwrite(counts, sizeof(int32_t), 2, file);
+    fwrite(moves, 1, bytes, file);
+    fclose(file);
+    free(moves);
+    return 1;
+}
+
+Path* load_encoded_path(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        warning("Could not open encoded path");
+        return NULL;
+    }
+
+    char magic[4];
+    int16_t header[3];
+    int32_t counts[2];
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, ENCODED_MAGIC, 4) != 0 ||
+        fread(header, sizeof(int16_t), 3, file) != 3 ||
+        fread(counts, sizeof(int32_t), 2, file) != 2 ||
+        counts[0] < 0 || counts[1] < 0 ||
+        counts[1] > ((long)counts[0] * (MOVE_BITS + ESCAPE_BITS) + 7) / 8) {
+        warning("Not an encoded path file");
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char* moves = (unsigned char*)safe_malloc(counts[1] > 0 ? counts[1] : 1);
+    int complete = (int)fread(moves, 1, counts[1], file) == counts[1];
+    fclose(file);
+
+    Path* path = create_path(counts[0]);
+    if (complete) {
+        path->length = decode_path_moves(create_coordinate(header[0], header[1], header[2]),
+                                         moves, counts[1], counts[0], path->coordinates);
+    }
+    free(moves);
+
+    if (path->length < counts[0]) {
+        warning("Encoded path file is truncated");
+        free_path(path);
+        return NULL;
+    }
+    return path;
+}
@@ -0,0 +1,50 @@
+#ifndef PATH_ENCODING_H
+#define PATH_ENCODING_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+#include "cell_path.h"
+
+// ===== Compact Move Encoding =====
+// A path is its first cell plus one 3-bit code per step, packed LSB first:
+//   0-5  unit move in direction order (+x, -x, +y, -y, +z, -z)
+//   6    escape: the next 48 bits hold the target cell as three int16s
+//   7    stay on the same cell
+// Valid paths cost 3 bits per step instead of a 12-byte Coordinate.
+
+#define MOVE_ESCAPE 6
+#define MOVE_STAY 7
+#define MOVE_BITS 3
+#define ESCAPE_BITS 48
+
+// Escape targets and the file header store int16 axes. Voxel import
+// rejects larger grids; the encoder refuses anything outside this range.
+#define MAX_ENCODED_COORDINATE INT16_MAX
+
+// Worst case: every step is an escape
+#define MAX_ENCODED_PATH_BYTES ((MAX_PATH_LENGTH * (MOVE_BITS + ESCAPE_BITS) + 7) / 8)
+
+// Returns the number of bytes written, or -1 if 'capacity' is too small or
+// an escape target does not fit in int16
+int encode_path_moves(const Coordinate* coordinates, int length,
+                      unsigned char* out, int capacity);
+// Cells of the longest prefix of 'coordinates' whose moves fit in
+// 'capacity' bytes ('length' when all do), or -1 if an escape target in
+// that prefix does not fit in int16
+int encoded_prefix_length(const Coordinate* coordinates, int length, int capacity);
+// Rebuilds 'length' cells (start included) into 'out'; returns the number
+// of cells decoded (less than 'length' if the data ends early)
+int decode_path_moves(Coordinate start, const unsigned char* moves, int bytes,
+                      int length, Coordinate* out);
+// Same, straight into cell ids (unit moves become a neighbor offset)
+int decode_path_cells(const Grid* grid, Coordinate start, const unsigned char* moves,
+                      int bytes, int length, CellId* out);
+
+// ===== Encoded Path Files =====
+// "RPM1", start (3 x int16), cell count (int32), byte count (int32), moves
+int save_encoded_path(const Path* path, const char* filename);
+// NULL (with a warning) if the file is missing, malformed or truncated
+Path* load_encoded_path(const char* filename);
+
+#endif // PATH_ENCODING_H
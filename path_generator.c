@@ -1,511 +1,1065 @@
-#include "path_generator.h"
-#include <float.h>
-
-// ===== Path Creation and Destruction =====
-
-Path* create_path(int initial_capacity) {
-    Path* path = (Path*)safe_malloc(sizeof(Path));
-    path->capacity = initial_capacity > 0 ? initial_capacity : 100;
-    path->coordinates = (Coordinate*)safe_malloc(path->capacity * sizeof(Coordinate));
-    path->length = 0;
-    path->survivors_reached = 0;
-    path->survivors_visited = NULL;
-    path->fitness = 0.0f;
-    path->collision_count = 0;
-    return path;
-}
-
-void free_path(Path* path) {
-    if (!path) return;
-    if (path->coordinates) free(path->coordinates);
-    if (path->survivors_visited) free(path->survivors_visited);
-    free(path);
-}
-
-Path* clone_path(const Path* path) {
-    if (!path) return NULL;
-    
-    Path* new_path = create_path(path->capacity);
-    new_path->length = path->length;
-    new_path->survivors_reached = path->survivors_reached;
-    new_path->fitness = path->fitness;
-    new_path->collision_count = path->collision_count;
-    
-    memcpy(new_path->coordinates, path->coordinates, 
-           path->length * sizeof(Coordinate));
-    
-    if (path->survivors_visited && path->survivors_reached > 0) {
-        new_path->survivors_visited = (int*)safe_malloc(
-            path->survivors_reached * sizeof(int));
-        memcpy(new_path->survivors_visited, path->survivors_visited,
-               path->survivors_reached * sizeof(int));
-    }
-    
-    return new_path;
-}
-
-// ===== Path Operations =====
-
-void add_coordinate_to_path(Path* path, Coordinate coord) {
-    if (path->length >= path->capacity) {
-        path->capacity *= 2;
-        path->coordinates = (Coordinate*)realloc(
-            path->coordinates, path->capacity * sizeof(Coordinate));
-        if (!path->coordinates) {
-            error_exit("Failed to resize path");
-        }
-    }
-    path->coordinates[path->length++] = coord;
-}
-
-void remove_last_coordinate(Path* path) {
-    if (path->length > 0) {
-        path->length--;
-    }
-}
-
-void clear_path(Path* path) {
-    path->length = 0;
-    path->survivors_reached = 0;
-    path->fitness = 0.0f;
-    path->collision_count = 0;
-    if (path->survivors_visited) {
-        free(path->survivors_visited);
-        path->survivors_visited = NULL;
-    }
-}
-
-int path_contains_coordinate(const Path* path, Coordinate coord) {
-    for (int i = 0; i < path->length; i++) {
-        if (coordinates_equal(path->coordinates[i], coord)) {
-            return 1;
-        }
-    }
-    return 0;
-}
-
-// ===== Path Validation =====
-
-int is_valid_path(const Path* path, const Grid* grid) {
-    if (!path || path->length == 0) return 0;
-    
-    for (int i = 0; i < path->length; i++) {
-        if (!is_valid_coordinate(grid, path->coordinates[i])) {
-            return 0;
-        }
-    }
-    return 1;
-}
-
-int check_path_collisions(const Path* path, const Grid* grid) {
-    int collisions = 0;
-    for (int i = 0; i < path->length; i++) {
-        if (is_obstacle(grid, path->coordinates[i])) {
-            collisions++;
-        }
-    }
-    return collisions;
-}
-
-int count_survivors_in_path(const Path* path, const Grid* grid) {
-    int count = 0;
-    int* found = (int*)calloc(grid->num_survivors, sizeof(int));
-    
-    for (int i = 0; i < path->length; i++) {
-        int survivor_idx = get_survivor_at(grid, path->coordinates[i]);
-        if (survivor_idx >= 0 && !found[survivor_idx]) {
-            found[survivor_idx] = 1;
-            count++;
-        }
-    }
-    
-    free(found);
-    return count;
-}
-
-// ===== NEW: Path Connectivity Functions =====
-
-int are_coordinates_adjacent(Coordinate c1, Coordinate c2) {
-    int dx = abs(c1.x - c2.x);
-    int dy = abs(c1.y - c2.y);
-    int dz = abs(c1.z - c2.z);
-    
-    // Adjacent means exactly one unit away in one direction
-    int total = dx + dy + dz;
-    return (total == 1);
-}
-
-Path* connect_coordinates(const Grid* grid, Coordinate from, Coordinate to) {
-    // Use A* to find connecting path
-    return find_path_astar(grid, from, to);
-}
-
-// ===== Heuristic Functions =====
-
-float heuristic_manhattan(Coordinate a, Coordinate b) {
-    return (float)manhattan_distance(a, b);
-}
-
-float heuristic_euclidean(Coordinate a, Coordinate b) {
-    return distance_3d(a, b);
-}
-
-float heuristic_3d(Coordinate a, Coordinate b) {
-    int dx = abs(a.x - b.x);
-    int dy = abs(a.y - b.y);
-    int dz = abs(a.z - b.z);
-    return sqrt(dx*dx + dy*dy + dz*dz*1.5);
-}
-
-// ===== A* Node Management =====
-
-static AStarNode* create_astar_node(Coordinate pos) {
-    AStarNode* node = (AStarNode*)safe_malloc(sizeof(AStarNode));
-    node->position = pos;
-    node->g_cost = FLT_MAX;
-    node->h_cost = 0;
-    node->f_cost = FLT_MAX;
-    node->parent = NULL;
-    node->is_closed = 0;
-    return node;
-}
-
-static int find_node_in_list(AStarNode** list, int size, Coordinate pos) {
-    for (int i = 0; i < size; i++) {
-        if (coordinates_equal(list[i]->position, pos)) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-static AStarNode* find_lowest_f_cost(AStarNode** open_list, int open_count) {
-    if (open_count == 0) return NULL;
-    
-    int min_idx = 0;
-    for (int i = 1; i < open_count; i++) {
-        if (open_list[i]->f_cost < open_list[min_idx]->f_cost) {
-            min_idx = i;
-        }
-    }
-    return open_list[min_idx];
-}
-
-// ===== A* Pathfinding Algorithm =====
-
-Path* find_path_astar(const Grid* grid, Coordinate start, Coordinate goal) {
-    if (!is_valid_coordinate(grid, start) || !is_valid_coordinate(grid, goal)) {
-        return NULL;
-    }
-    
-    if (is_obstacle(grid, goal) && !is_survivor(grid, goal)) {
-        return NULL;
-    }
-    
-    int max_nodes = grid->size_x * grid->size_y * grid->size_z;
-    AStarNode** open_list = (AStarNode**)safe_malloc(max_nodes * sizeof(AStarNode*));
-    AStarNode** closed_list = (AStarNode**)safe_malloc(max_nodes * sizeof(AStarNode*));
-    AStarNode** all_nodes = (AStarNode**)safe_malloc(max_nodes * sizeof(AStarNode*));
-    
-    int open_count = 0;
-    int closed_count = 0;
-    int total_nodes = 0;
-    
-    AStarNode* start_node = create_astar_node(start);
-    start_node->g_cost = 0;
-    start_node->h_cost = heuristic_3d(start, goal);
-    start_node->f_cost = start_node->g_cost + start_node->h_cost;
-    
-    open_list[open_count++] = start_node;
-    all_nodes[total_nodes++] = start_node;
-    
-    AStarNode* goal_node = NULL;
-    
-    while (open_count > 0) {
-        AStarNode* current = find_lowest_f_cost(open_list, open_count);
-        
-        if (coordinates_equal(current->position, goal)) {
-            goal_node = current;
-            break;
-        }
-        
-        for (int i = 0; i < open_count; i++) {
-            if (open_list[i] == current) {
-                open_list[i] = open_list[--open_count];
-                break;
-            }
-        }
-        closed_list[closed_count++] = current;
-        current->is_closed = 1;
-        
-        Coordinate neighbors[6];
-        int neighbor_count = get_walkable_neighbors(grid, current->position, neighbors);
-        
-        for (int i = 0; i < neighbor_count; i++) {
-            Coordinate neighbor_pos = neighbors[i];
-            
-            int in_closed = find_node_in_list(closed_list, closed_count, neighbor_pos);
-            if (in_closed >= 0) continue;
-            
-            float tentative_g = current->g_cost + 1.0f;
-            
-            if (is_obstacle(grid, neighbor_pos)) {
-                tentative_g += 10.0f;
-            }
-            
-            int in_open = find_node_in_list(open_list, open_count, neighbor_pos);
-            AStarNode* neighbor_node = NULL;
-            
-            if (in_open >= 0) {
-                neighbor_node = open_list[in_open];
-                if (tentative_g < neighbor_node->g_cost) {
-                    neighbor_node->g_cost = tentative_g;
-                    neighbor_node->h_cost = heuristic_3d(neighbor_pos, goal);
-                    neighbor_node->f_cost = neighbor_node->g_cost + neighbor_node->h_cost;
-                    neighbor_node->parent = current;
-                }
-            } else {
-                neighbor_node = create_astar_node(neighbor_pos);
-                neighbor_node->g_cost = tentative_g;
-                neighbor_node->h_cost = heuristic_3d(neighbor_pos, goal);
-                neighbor_node->f_cost = neighbor_node->g_cost + neighbor_node->h_cost;
-                neighbor_node->parent = current;
-                
-                open_list[open_count++] = neighbor_node;
-                all_nodes[total_nodes++] = neighbor_node;
-            }
-        }
-        
-        if (total_nodes >= max_nodes - 100) {
-            warning("A* search space too large, stopping");
-            break;
-        }
-    }
-    
-    Path* path = NULL;
-    if (goal_node) {
-        path = create_path(100);
-        
-        AStarNode* current = goal_node;
-        while (current) {
-            add_coordinate_to_path(path, current->position);
-            current = current->parent;
-        }
-        
-        for (int i = 0; i < path->length / 2; i++) {
-            Coordinate temp = path->coordinates[i];
-            path->coordinates[i] = path->coordinates[path->length - 1 - i];
-            path->coordinates[path->length - 1 - i] = temp;
-        }
-        
-        path->collision_count = check_path_collisions(path, grid);
-    }
-    
-    for (int i = 0; i < total_nodes; i++) {
-        free(all_nodes[i]);
-    }
-    free(open_list);
-    free(closed_list);
-    free(all_nodes);
-    
-    return path;
-}
-
-// ===== Path to Nearest Survivor =====
-
-Path* find_path_to_nearest_survivor(const Grid* grid, Coordinate start, 
-                                     const int* visited_survivors) {
-    float min_distance = FLT_MAX;
-    int nearest_survivor = -1;
-    
-    for (int i = 0; i < grid->num_survivors; i++) {
-        if (visited_survivors && visited_survivors[i]) continue;
-        
-        Coordinate survivor_pos = grid->survivors[i];
-        float dist = distance_3d(start, survivor_pos);
-        
-        if (dist < min_distance) {
-            min_distance = dist;
-            nearest_survivor = i;
-        }
-    }
-    
-    if (nearest_survivor < 0) return NULL;
-    
-    Coordinate goal = grid->survivors[nearest_survivor];
-    return find_path_astar(grid, start, goal);
-}
-
-// ===== Random Path Generation =====
-
-Path* generate_random_path(const Grid* grid, int max_length) {
-    Path* path = create_path(max_length);
-    Coordinate current = grid->start;
-    add_coordinate_to_path(path, current);
-    
-    for (int i = 0; i < max_length && path->length < max_length; i++) {
-        Coordinate neighbors[6];
-        int neighbor_count = get_neighbors(grid, current, neighbors);
-        
-        if (neighbor_count == 0) break;
-        
-        int attempts = 0;
-        Coordinate next = current;
-        while (attempts < 10) {
-            int rand_idx = random_int(0, neighbor_count - 1);
-            next = neighbors[rand_idx];
-            
-            if (is_walkable(grid, next)) {
-                break;
-            }
-            attempts++;
-        }
-        
-        if (!coordinates_equal(next, current)) {
-            add_coordinate_to_path(path, next);
-            current = next;
-        } else {
-            break;
-        }
-    }
-    
-    path->collision_count = check_path_collisions(path, grid);
-    path->survivors_reached = count_survivors_in_path(path, grid);
-    
-    return path;
-}
-
-// ===== Greedy Path Generation =====
-
-Path* generate_greedy_path(const Grid* grid) {
-    Path* path = create_path(100);
-    Coordinate current = grid->start;
-    add_coordinate_to_path(path, current);
-    
-    int* visited = (int*)calloc(grid->num_survivors, sizeof(int));
-    int survivors_found = 0;
-    
-    while (survivors_found < grid->num_survivors) {
-        Path* segment = find_path_to_nearest_survivor(grid, current, visited);
-        
-        if (!segment || segment->length == 0) break;
-        
-        for (int i = 1; i < segment->length; i++) {
-            add_coordinate_to_path(path, segment->coordinates[i]);
-        }
-        
-        current = segment->coordinates[segment->length - 1];
-        
-        int survivor_idx = get_survivor_at(grid, current);
-        if (survivor_idx >= 0) {
-            visited[survivor_idx] = 1;
-            survivors_found++;
-        }
-        
-        free_path(segment);
-        
-        if (path->length > MAX_PATH_LENGTH) break;
-    }
-    
-    free(visited);
-    
-    path->collision_count = check_path_collisions(path, grid);
-    path->survivors_reached = count_survivors_in_path(path, grid);
-    
-    return path;
-}
-
-// ===== Population Generation =====
-
-Path** generate_initial_population(const Grid* grid, const Config* config, int* pop_size) {
-    int target_size = config->population_size;
-    Path** population = (Path**)safe_malloc(target_size * sizeof(Path*));
-    
-    int generated = 0;
-    
-    int greedy_count = target_size / 10;
-    if (greedy_count < 1) greedy_count = 1;
-    
-    for (int i = 0; i < greedy_count && generated < target_size; i++) {
-        population[generated++] = generate_greedy_path(grid);
-    }
-    
-    while (generated < target_size) {
-        int path_length = random_int(20, MAX_PATH_LENGTH / 2);
-        population[generated++] = generate_random_path(grid, path_length);
-    }
-    
-    *pop_size = generated;
-    return population;
-}
-
-// ===== Path Utilities =====
-
-void print_path(const Path* path) {
-    if (!path) {
-        printf("Path is NULL\n");
-        return;
-    }
-    
-    printf("Path (length=%d, survivors=%d, collisions=%d, fitness=%.2f):\n",
-           path->length, path->survivors_reached, path->collision_count, path->fitness);
-    
-    for (int i = 0; i < path->length && i < 20; i++) {
-        printf("  [%d] (%d, %d, %d)\n", i,
-               path->coordinates[i].x,
-               path->coordinates[i].y,
-               path->coordinates[i].z);
-    }
-    
-    if (path->length > 20) {
-        printf("  ... (%d more coordinates)\n", path->length - 20);
-    }
-}
-
-void save_path_to_file(const Path* path, const char* filename) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        warning("Could not save path to file");
-        return;
-    }
-    
-    fprintf(file, "Path Length: %d\n", path->length);
-    fprintf(file, "Survivors Reached: %d\n", path->survivors_reached);
-    fprintf(file, "Collisions: %d\n", path->collision_count);
-    fprintf(file, "Fitness: %.2f\n\n", path->fitness);
-    
-    fprintf(file, "Coordinates:\n");
-    for (int i = 0; i < path->length; i++) {
-        fprintf(file, "%d: (%d, %d, %d)\n", i,
-                path->coordinates[i].x,
-                path->coordinates[i].y,
-                path->coordinates[i].z);
-    }
-    
-    fclose(file);
-}
-
-float calculate_path_length_euclidean(const Path* path) {
-    float total = 0.0f;
-    for (int i = 1; i < path->length; i++) {
-        total += distance_3d(path->coordinates[i-1], path->coordinates[i]);
-    }
-    return total;
-}
-
-int calculate_path_length_manhattan(const Path* path) {
-    int total = 0;
-    for (int i = 1; i < path->length; i++) {
-        total += manhattan_distance(path->coordinates[i-1], path->coordinates[i]);
-    }
-    return total;
-}
-
-int compare_paths_by_fitness(const void* a, const void* b) {
-    Path* path_a = *(Path**)a;
-    Path* path_b = *(Path**)b;
-    
-    if (path_a->fitness > path_b->fitness) return -1;
-    if (path_a->fitness < path_b->fitness) return 1;
-    return 0;
-}
+#include "path_generator.h"
+#include "search_queue.h"
+#include "distance_tables.h"
+#include "jump_point_search.h"
+#include "path_hierarchy.h"
+#include "landmarks.h"
+#include "connector_cache.h"
+#include "path_arena.h"
+#include <float.h>
+
+// ===== Path Creation and Destruction =====
+
+// Path struct without a coordinate buffer, from the active arena if any
+static Path* new_path_struct(void) {
+    PathArena* arena = active_path_arena();
+    Path* path = arena ? (Path*)path_arena_alloc(arena, sizeof(Path))
+                       : (Path*)safe_malloc(sizeof(Path));
+    path->coordinates = NULL;
+    path->capacity = 0;
+    path->length = 0;
+    path->survivors_reached = 0;
+    path->survivors_visited = NULL;
+    path->fitness = 0.0f;
+    path->collision_count = 0;
+    path->arena = arena;
+    path->body = NULL;
+    return path;
+}
+
+static Coordinate* alloc_coordinates(const Path* path, int capacity) {
+    size_t bytes = capacity * sizeof(Coordinate);
+    return path->arena ? (Coordinate*)path_arena_alloc(path->arena, bytes)
+                       : (Coordinate*)safe_malloc(bytes);
+}
+
+Path* create_path(int initial_capacity) {
+    Path* path = new_path_struct();
+    path->capacity = initial_capacity > 0 ? initial_capacity : 100;
+    path->coordinates = alloc_coordinates(path, path->capacity);
+    return path;
+}
+
+// Arena paths are released all at once by reset_path_arena(), which also
+// drops their body references
+void free_path(Path* path) {
+    if (!path || path->arena) return;
+    if (path->body) {
+        release_path_body(path->body);
+    } else if (path->coordinates) {
+        free(path->coordinates);
+    }
+    if (path->survivors_visited) free(path->survivors_visited);
+    free(path);
+}
+
+static void copy_path_scores(Path* dest, const Path* path) {
+    dest->length = path->length;
+    dest->survivors_reached = path->survivors_reached;
+    dest->fitness = path->fitness;
+    dest->collision_count = path->collision_count;
+    
+    if (path->survivors_visited && path->survivors_reached > 0) {
+        size_t bytes = path->survivors_reached * sizeof(int);
+        dest->survivors_visited = dest->arena
+            ? (int*)path_arena_alloc(dest->arena, bytes)
+            : (int*)safe_malloc(bytes);
+        memcpy(dest->survivors_visited, path->survivors_visited, bytes);
+    }
+}
+
+Path* clone_path(const Path* path) {
+    if (!path) return NULL;
+    
+    Path* new_path = create_path(path->capacity);
+    memcpy(new_path->coordinates, path->coordinates, 
+           path->length * sizeof(Coordinate));
+    copy_path_scores(new_path, path);
+    return new_path;
+}
+
+// ===== Shared Path Bodies =====
+
+void release_path_body(PathBody* body) {
+    if (body && --body->refcount == 0) {
+        free(body);
+    }
+}
+
+// Every path holding a body owns one reference; an arena path's is handed
+// to its arena and dropped on reset
+static void retain_path_body(Path* path, PathBody* body) {
+    body->refcount++;
+    path->body = body;
+    path->coordinates = body->coordinates;
+    path->capacity = body->capacity;
+    if (path->arena) {
+        path_arena_retain_body(path->arena, body);
+    }
+}
+
+Path* share_path(Path* path) {
+    if (!path) return NULL;
+    
+    // First share: the cells move into a body that both paths point at
+    if (!path->body) {
+        int capacity = path->length > 0 ? path->length : 1;
+        PathBody* body = (PathBody*)safe_malloc(sizeof(PathBody) +
+                                                capacity * sizeof(Coordinate));
+        body->refcount = 0;
+        body->capacity = capacity;
+        memcpy(body->coordinates, path->coordinates, path->length * sizeof(Coordinate));
+        if (!path->arena) {
+            free(path->coordinates);
+        }
+        retain_path_body(path, body);
+    }
+    
+    Path* copy = new_path_struct();
+    retain_path_body(copy, path->body);
+    copy_path_scores(copy, path);
+    return copy;
+}
+
+// Give the path a private buffer of at least 'capacity' cells
+static void detach_path_body(Path* path, int capacity) {
+    PathBody* body = path->body;
+    if (capacity < path->capacity) capacity = path->capacity;
+    
+    path->coordinates = alloc_coordinates(path, capacity);
+    memcpy(path->coordinates, body->coordinates, path->length * sizeof(Coordinate));
+    path->capacity = capacity;
+    path->body = NULL;
+    if (!path->arena) {
+        release_path_body(body);
+    }
+}
+
+// A body with a single reference belongs to this path alone and is
+// written in place
+void make_path_writable(Path* path) {
+    if (path->body && path->body->refcount > 1) {
+        detach_path_body(path, path->capacity);
+    }
+}
+
+// ===== Path Operations =====
+
+// Grow the coordinate buffer to at least 'capacity'; an arena path moves
+// to a new buffer from its own arena. A shared path always gets its own.
+void reserve_path_capacity(Path* path, int capacity) {
+    if (path->body) {
+        if (capacity > path->capacity || path->body->refcount > 1) {
+            detach_path_body(path, capacity);
+        }
+        return;
+    }
+    if (capacity <= path->capacity) return;
+    
+    if (path->arena) {
+        Coordinate* coordinates = (Coordinate*)path_arena_alloc(
+            path->arena, capacity * sizeof(Coordinate));
+        memcpy(coordinates, path->coordinates, path->length * sizeof(Coordinate));
+        path->coordinates = coordinates;
+    } else {
+        path->coordinates = (Coordinate*)realloc(
+            path->coordinates, capacity * sizeof(Coordinate));
+        if (!path->coordinates) {
+            error_exit("Failed to resize path");
+        }
+    }
+    path->capacity = capacity;
+}
+
+void add_coordinate_to_path(Path* path, Coordinate coord) {
+    if (path->length >= path->capacity) {
+        reserve_path_capacity(path, path->capacity * 2);
+    }
+    path->coordinates[path->length++] = coord;
+}
+
+// ===== Path Validation =====
+
+int is_valid_path(const Path* path, const Grid* grid) {
+    if (!path || path->length == 0) return 0;
+    
+    for (int i = 0; i < path->length; i++) {
+        if (!is_valid_coordinate(grid, path->coordinates[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int check_path_collisions(const Path* path, const Grid* grid) {
+    int collisions = 0;
+    for (int i = 0; i < path->length; i++) {
+        if (is_obstacle(grid, path->coordinates[i])) {
+            collisions++;
+        }
+    }
+    return collisions;
+}
+
+int count_survivors_in_path(const Path* path, const Grid* grid) {
+    int count = 0;
+    int* found = (int*)calloc(grid->num_survivors, sizeof(int));
+    
+    for (int i = 0; i < path->length; i++) {
+        int survivor_idx = get_survivor_at(grid, path->coordinates[i]);
+        if (survivor_idx >= 0 && !found[survivor_idx]) {
+            found[survivor_idx] = 1;
+            count++;
+        }
+    }
+    
+    free(found);
+    return count;
+}
+
+// ===== Pathfinding Settings =====
+
+static AStarQueueType astar_queue_type = ASTAR_QUEUE_HEAP;
+static PathfinderType pathfinder_type = PATHFINDER_ASTAR;
+static int hpa_min_cells = 0;
+static int bidirectional_threshold = 0;   // 0 = not calibrated yet, -1 = off
+
+// Apply pathfinding options (call before workers are forked)
+void configure_pathfinding(const Config* config) {
+    astar_queue_type = (AStarQueueType)config->astar_queue;
+    pathfinder_type = (PathfinderType)config->pathfinder;
+    hpa_min_cells = config->hpa_min_cells;
+    bidirectional_threshold = config->bidirectional_threshold;
+    configure_hierarchy(config);
+    configure_landmarks(config);
+}
+
+// The hierarchy only repays its build cost and its longer paths on large
+// grids; below HPA_MIN_CELLS the hpa setting searches with A* instead
+static inline int use_hierarchy(const Grid* grid) {
+    return pathfinder_type == PATHFINDER_HPA && grid->total_cells >= hpa_min_cells;
+}
+
+// ===== NEW: Path Connectivity Functions =====
+
+int are_coordinates_adjacent(Coordinate c1, Coordinate c2) {
+    int dx = abs(c1.x - c2.x);
+    int dy = abs(c1.y - c2.y);
+    int dz = abs(c1.z - c2.z);
+    
+    // Adjacent means exactly one unit away in one direction
+    int total = dx + dy + dz;
+    return (total == 1);
+}
+
+static Path* search_connector(const Grid* grid, Coordinate from, Coordinate to,
+                              SearchContext* ctx) {
+    if (use_hierarchy(grid)) {
+        return find_path_hpa(grid, from, to, ctx);
+    }
+    
+    // Long-range connectors: meet in the middle instead
+    if (bidirectional_threshold > 0 &&
+        manhattan_distance(from, to) >= bidirectional_threshold) {
+        return find_path_bidirectional(grid, from, to, ctx);
+    }
+    if (pathfinder_type == PATHFINDER_JPS) {
+        return find_path_jps(grid, from, to, ctx);
+    }
+    return find_path_astar(grid, from, to, ctx);
+}
+
+// Crossover keeps splicing between the same few fragment ends, so found
+// connectors go through the shared cache when one has been created
+Path* connect_coordinates(const Grid* grid, Coordinate from, Coordinate to,
+                          SearchContext* ctx) {
+    if (!connector_cache_enabled() ||
+        !is_valid_coordinate(grid, from) || !is_valid_coordinate(grid, to)) {
+        return search_connector(grid, from, to, ctx);
+    }
+
+    int from_cell = cell_index(grid, from);
+    int to_cell = cell_index(grid, to);
+    Path* path = connector_cache_lookup(grid, from_cell, to_cell);
+    if (path) return path;
+
+    // A pair is always searched low cell to high, so a cached path and a
+    // fresh one agree whichever direction (or process) filled the entry
+    if (from_cell <= to_cell) {
+        path = search_connector(grid, from, to, ctx);
+    } else {
+        path = search_connector(grid, to, from, ctx);
+        for (int i = 0, j = path ? path->length - 1 : -1; i < j; i++, j--) {
+            Coordinate swap = path->coordinates[i];
+            path->coordinates[i] = path->coordinates[j];
+            path->coordinates[j] = swap;
+        }
+    }
+    connector_cache_store(grid, from_cell, to_cell, path);
+    return path;
+}
+
+// ===== Heuristic Functions =====
+
+float heuristic_manhattan(Coordinate a, Coordinate b) {
+    return (float)manhattan_distance(a, b);
+}
+
+float heuristic_euclidean(Coordinate a, Coordinate b) {
+    return distance_3d(a, b);
+}
+
+float heuristic_3d(Coordinate a, Coordinate b) {
+    int dx = abs(a.x - b.x);
+    int dy = abs(a.y - b.y);
+    int dz = abs(a.z - b.z);
+    return sqrt(dx*dx + dy*dy + dz*dz*1.5);
+}
+
+// ===== Search Context =====
+
+SearchContext* create_search_context(const Grid* grid) {
+    int cells = grid->total_cells;
+    SearchContext* ctx = (SearchContext*)safe_malloc(sizeof(SearchContext));
+    ctx->num_cells = cells;
+    ctx->generation = 0;
+    ctx->expansions = 0;
+    ctx->stamp = (unsigned int*)safe_calloc(cells, sizeof(unsigned int));
+    ctx->g = (float*)safe_malloc(cells * sizeof(float));
+    ctx->f = (float*)safe_malloc(cells * sizeof(float));
+    ctx->parent = (int*)safe_malloc(cells * sizeof(int));
+    ctx->state = (unsigned char*)safe_malloc(cells * sizeof(unsigned char));
+    ctx->queue_items = (int*)safe_malloc(cells * sizeof(int));
+    ctx->queue_position = (int*)safe_malloc(cells * sizeof(int));
+    ctx->queue_prev = (int*)safe_malloc(cells * sizeof(int));
+    ctx->queue_key = (int*)safe_malloc(cells * sizeof(int));
+    ctx->backward_links = NULL;
+    return ctx;
+}
+
+void free_search_context(SearchContext* ctx) {
+    if (!ctx) return;
+    free(ctx->stamp);
+    free(ctx->g);
+    free(ctx->f);
+    free(ctx->parent);
+    free(ctx->state);
+    free(ctx->queue_items);
+    free(ctx->queue_position);
+    free(ctx->queue_prev);
+    free(ctx->queue_key);
+    free(ctx->backward_links);
+    free(ctx);
+}
+
+static _Thread_local SearchContext* thread_search_context = NULL;
+
+// Lazily created per thread (and so per forked worker); regrown if the
+// grid dimensions change
+SearchContext* default_search_context(const Grid* grid) {
+    if (!thread_search_context || thread_search_context->num_cells != grid->total_cells) {
+        free_search_context(thread_search_context);
+        thread_search_context = create_search_context(grid);
+    }
+    return thread_search_context;
+}
+
+// Walk parent links back from the goal into a start-to-goal path
+static Path* build_path_from_parents(const Grid* grid, const int* parent, int goal) {
+    int length = 0;
+    for (int cell = goal; cell >= 0; cell = parent[cell]) {
+        length++;
+    }
+    
+    Path* path = create_path(length);
+    path->length = length;
+    int i = length - 1;
+    for (int cell = goal; cell >= 0; cell = parent[cell]) {
+        path->coordinates[i--] = cell_coordinate(grid, cell);
+    }
+    return path;
+}
+
+// ===== A* Pathfinding Algorithm =====
+
+Path* find_path_astar(const Grid* grid, Coordinate start, Coordinate goal,
+                      SearchContext* ctx) {
+    if (!is_valid_coordinate(grid, start) || !is_valid_coordinate(grid, goal)) {
+        return NULL;
+    }
+    
+    if (is_obstacle(grid, goal) && !is_survivor(grid, goal)) {
+        return NULL;
+    }
+    
+    // Different walkable components: no route exists, skip the search
+    if (!cells_connected(grid, start, goal)) {
+        return NULL;
+    }
+    
+    if (!ctx || ctx->num_cells != grid->total_cells) {
+        ctx = default_search_context(grid);
+    }
+    begin_search(ctx);
+    
+    int use_buckets = (astar_queue_type == ASTAR_QUEUE_BUCKET);
+    IndexedHeap heap;
+    BucketQueue buckets;
+    heap_init(&heap, ctx->queue_items, ctx->queue_position, ctx->f, ctx->g);
+    bucket_init(&buckets, ctx->queue_position, ctx->queue_prev, ctx->queue_key);
+    
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    
+    int start_cell = cell_index(grid, start);
+    int goal_cell = cell_index(grid, goal);
+    
+    // Landmark lower bounds when available, else the geometric heuristics
+    const LandmarkTable* landmarks = get_landmark_table(grid);
+    LandmarkGoal landmark_target;
+    if (landmarks) landmark_goal(landmarks, grid, goal_cell, &landmark_target);
+    
+    ctx->g[start_cell] = 0.0f;
+    ctx->f[start_cell] = landmarks ? (float)landmark_heuristic(landmarks, &landmark_target, start_cell, start)
+                       : use_buckets ? heuristic_manhattan(start, goal) : heuristic_3d(start, goal);
+    ctx->parent[start_cell] = -1;
+    set_search_state(ctx, start_cell, SEARCH_OPEN);
+    if (use_buckets) bucket_push(&buckets, start_cell, (int)ctx->f[start_cell]);
+    else heap_push(&heap, start_cell);
+    
+    int found = 0;
+    for (;;) {
+        int current = use_buckets ? bucket_pop(&buckets) : heap_pop(&heap);
+        if (current < 0) break;
+        ctx->expansions++;
+        
+        if (current == goal_cell) {
+            found = 1;
+            break;
+        }
+        ctx->state[current] = SEARCH_CLOSED;
+        
+        unsigned char mask = grid->neighbor_mask[current];
+        float tentative_g = ctx->g[current] + 1.0f;
+        
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(mask & (1 << d))) continue;
+            
+            int next = current + offsets[d];
+            unsigned char state = search_state(ctx, next);
+            if (state == SEARCH_CLOSED) continue;
+            if (state == SEARCH_OPEN && tentative_g >= ctx->g[next]) continue;
+            
+            Coordinate next_pos = cell_coordinate(grid, next);
+            float h = landmarks ? (float)landmark_heuristic(landmarks, &landmark_target, next, next_pos)
+                    : use_buckets ? heuristic_manhattan(next_pos, goal) : heuristic_3d(next_pos, goal);
+            ctx->g[next] = tentative_g;
+            ctx->f[next] = tentative_g + h;
+            ctx->parent[next] = current;
+            
+            if (state == SEARCH_UNSEEN) {
+                set_search_state(ctx, next, SEARCH_OPEN);
+                if (use_buckets) bucket_push(&buckets, next, (int)ctx->f[next]);
+                else heap_push(&heap, next);
+            } else {
+                if (use_buckets) bucket_decrease(&buckets, next, (int)ctx->f[next]);
+                else heap_decrease(&heap, next);
+            }
+        }
+    }
+    
+    Path* path = NULL;
+    if (found) {
+        path = build_path_from_parents(grid, ctx->parent, goal_cell);
+        path->collision_count = check_path_collisions(path, grid);
+    }
+    
+    return path;
+}
+
+// ===== Bidirectional Search =====
+
+// Per-side search state bits: a cell can be reached from both ends
+#define FORWARD_OPEN 1
+#define FORWARD_CLOSED 2
+#define BACKWARD_OPEN 4
+#define BACKWARD_CLOSED 8
+
+// Lower bounds toward both ends (ALT when landmarks are built, else Manhattan)
+typedef struct {
+    const LandmarkTable* landmarks;
+    LandmarkGoal to_start;
+    LandmarkGoal to_goal;
+    Coordinate start;
+    Coordinate goal;
+} BalancedPotential;
+
+// h_goal(cell) - h_start(cell): twice the forward potential and minus twice
+// the backward one. Both sides then see the same reduced edge costs, so
+// their searches can stop as soon as their frontiers cover the best meeting.
+static int potential_balance(const Grid* grid, const BalancedPotential* p, int cell) {
+    Coordinate pos = cell_coordinate(grid, cell);
+    if (p->landmarks) {
+        return landmark_heuristic(p->landmarks, &p->to_goal, cell, pos) -
+               landmark_heuristic(p->landmarks, &p->to_start, cell, pos);
+    }
+    return manhattan_distance(pos, p->goal) - manhattan_distance(pos, p->start);
+}
+
+typedef struct {
+    BucketQueue queue;       // Keyed 2g +/- balance (never negative)
+    float* g;                // Steps from this side's end
+    int* parent;             // Next cell toward this side's end
+    unsigned char open;
+    unsigned char closed;
+    int sign;                // +1 forward, -1 backward
+} SearchSide;
+
+// Pop one cell of 'side' and relax its edges. Every time a cell's label
+// drops on one side while the other side has reached it, the meeting
+// length through it is offered to *best.
+static void expand_side(const Grid* grid, SearchContext* ctx, const int* offsets,
+                        const BalancedPotential* potential, SearchSide* side,
+                        const SearchSide* other, int* best, int* meet) {
+    int current = bucket_pop(&side->queue);
+    ctx->expansions++;
+    set_search_state(ctx, current, (search_state(ctx, current) & ~side->open) | side->closed);
+    
+    unsigned char mask = grid->neighbor_mask[current];
+    float next_g = side->g[current] + 1.0f;
+    
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(mask & (1 << d))) continue;
+        
+        int next = current + offsets[d];
+        unsigned char state = search_state(ctx, next);
+        if (state & side->closed) continue;
+        if ((state & side->open) && next_g >= side->g[next]) continue;
+        
+        side->g[next] = next_g;
+        side->parent[next] = current;
+        int key = 2 * (int)next_g + side->sign * potential_balance(grid, potential, next);
+        if (state & side->open) {
+            bucket_decrease(&side->queue, next, key);
+        } else {
+            set_search_state(ctx, next, state | side->open);
+            bucket_push(&side->queue, next, key);
+        }
+        
+        if (state & (other->open | other->closed)) {
+            int length = (int)(next_g + other->g[next]);
+            if (*best < 0 || length < *best) {
+                *best = length;
+                *meet = next;
+            }
+        }
+    }
+}
+
+// Bidirectional A* with balanced potentials p = (h_goal - h_start) / 2
+// forward and -p backward (Ikeda et al.), keyed in half steps so both
+// queues stay integer Dial buckets. Growing the smaller frontier, it stops
+// once the two smallest keys sum to twice the best meeting length, which
+// is then a shortest path.
+Path* find_path_bidirectional(const Grid* grid, Coordinate start, Coordinate goal,
+                              SearchContext* ctx) {
+    if (!is_valid_coordinate(grid, start) || !is_valid_coordinate(grid, goal)) {
+        return NULL;
+    }
+    
+    if (is_obstacle(grid, goal) && !is_survivor(grid, goal)) {
+        return NULL;
+    }
+    
+    if (!cells_connected(grid, start, goal)) {
+        return NULL;
+    }
+    
+    if (!ctx || ctx->num_cells != grid->total_cells) {
+        ctx = default_search_context(grid);
+    }
+    if (!ctx->backward_links) {
+        ctx->backward_links = (int*)safe_malloc(3 * (size_t)ctx->num_cells * sizeof(int));
+    }
+    begin_search(ctx);
+    
+    int start_cell = cell_index(grid, start);
+    int goal_cell = cell_index(grid, goal);
+    if (start_cell == goal_cell) {
+        Path* path = create_path(1);
+        add_coordinate_to_path(path, start);
+        return path;
+    }
+    
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    
+    BalancedPotential potential;
+    potential.landmarks = get_landmark_table(grid);
+    potential.start = start;
+    potential.goal = goal;
+    if (potential.landmarks) {
+        landmark_goal(potential.landmarks, grid, start_cell, &potential.to_start);
+        landmark_goal(potential.landmarks, grid, goal_cell, &potential.to_goal);
+    }
+    
+    // Forward side: g/parent and the A* bucket links.
+    // Backward side: f/queue_items and backward_links.
+    int* links = ctx->backward_links;
+    SearchSide forward = {.g = ctx->g, .parent = ctx->parent,
+                          .open = FORWARD_OPEN, .closed = FORWARD_CLOSED, .sign = 1};
+    SearchSide backward = {.g = ctx->f, .parent = ctx->queue_items,
+                           .open = BACKWARD_OPEN, .closed = BACKWARD_CLOSED, .sign = -1};
+    bucket_init(&forward.queue, ctx->queue_position, ctx->queue_prev, ctx->queue_key);
+    bucket_init(&backward.queue, links, links + ctx->num_cells, links + 2 * ctx->num_cells);
+    
+    forward.g[start_cell] = 0.0f;
+    forward.parent[start_cell] = -1;
+    set_search_state(ctx, start_cell, FORWARD_OPEN);
+    bucket_push(&forward.queue, start_cell, potential_balance(grid, &potential, start_cell));
+    
+    backward.g[goal_cell] = 0.0f;
+    backward.parent[goal_cell] = -1;
+    set_search_state(ctx, goal_cell, BACKWARD_OPEN);
+    bucket_push(&backward.queue, goal_cell, -potential_balance(grid, &potential, goal_cell));
+    
+    int best = -1;
+    int meet = -1;
+    while (forward.queue.size > 0 && backward.queue.size > 0) {
+        if (best >= 0 &&
+            bucket_min_key(&forward.queue) + bucket_min_key(&backward.queue) >= 2 * best) {
+            break;
+        }
+        if (forward.queue.size <= backward.queue.size) {
+            expand_side(grid, ctx, offsets, &potential, &forward, &backward, &best, &meet);
+        } else {
+            expand_side(grid, ctx, offsets, &potential, &backward, &forward, &best, &meet);
+        }
+    }
+    
+    if (best < 0) return NULL;
+    
+    Path* path = create_path(best + 1);
+    path->length = best + 1;
+    int i = (int)forward.g[meet];
+    for (int cell = meet; cell >= 0; cell = forward.parent[cell]) {
+        path->coordinates[i--] = cell_coordinate(grid, cell);
+    }
+    i = (int)forward.g[meet] + 1;
+    for (int cell = backward.parent[meet]; cell >= 0; cell = backward.parent[cell]) {
+        path->coordinates[i++] = cell_coordinate(grid, cell);
+    }
+    
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
+
+// ===== Bidirectional Threshold =====
+
+#define CALIBRATION_QUERIES 64
+#define CALIBRATION_SEED 0x5EED35ULL
+
+typedef struct {
+    int distance;            // Manhattan distance between the ends
+    long long one_sided;     // Expansions of the connector search it replaces
+    long long two_sided;
+} CalibrationQuery;
+
+static int compare_calibration_queries(const void* a, const void* b) {
+    const CalibrationQuery* qa = (const CalibrationQuery*)a;
+    const CalibrationQuery* qb = (const CalibrationQuery*)b;
+    return (qa->distance > qb->distance) - (qa->distance < qb->distance);
+}
+
+static long long count_expansions(const Grid* grid, Coordinate from, Coordinate to,
+                                  SearchContext* ctx, int two_sided) {
+    long long before = ctx->expansions;
+    Path* path = two_sided ? find_path_bidirectional(grid, from, to, ctx)
+               : pathfinder_type == PATHFINDER_JPS ? find_path_jps(grid, from, to, ctx)
+               : find_path_astar(grid, from, to, ctx);
+    free_path(path);
+    return ctx->expansions - before;
+}
+
+// Counted in expansions rather than time, so every process and every run
+// with the same grid settles on the same threshold. The threshold is the
+// sample distance that minimises the total expansions when every query at
+// least that far apart goes bidirectional.
+int calibrate_bidirectional_threshold(const Grid* grid) {
+    if (bidirectional_threshold != 0) return bidirectional_threshold;
+    bidirectional_threshold = -1;
+    if (use_hierarchy(grid)) return bidirectional_threshold;
+    
+    Rng rng;
+    rng_seed(&rng, CALIBRATION_SEED);
+    SearchContext* ctx = create_search_context(grid);
+    CalibrationQuery queries[CALIBRATION_QUERIES];
+    int count = 0;
+    
+    for (int attempt = 0; attempt < 8 * CALIBRATION_QUERIES && count < CALIBRATION_QUERIES; attempt++) {
+        int from_cell = (int)rng_range(&rng, (uint32_t)grid->total_cells);
+        int to_cell = (int)rng_range(&rng, (uint32_t)grid->total_cells);
+        if (from_cell == to_cell ||
+            grid->cell_data[from_cell] == CELL_OBSTACLE || grid->cell_data[to_cell] == CELL_OBSTACLE) {
+            continue;
+        }
+        Coordinate from = cell_coordinate(grid, from_cell);
+        Coordinate to = cell_coordinate(grid, to_cell);
+        if (!cells_connected(grid, from, to)) continue;
+        
+        queries[count].distance = manhattan_distance(from, to);
+        queries[count].one_sided = count_expansions(grid, from, to, ctx, 0);
+        queries[count].two_sided = count_expansions(grid, from, to, ctx, 1);
+        count++;
+    }
+    free_search_context(ctx);
+    qsort(queries, count, sizeof(CalibrationQuery), compare_calibration_queries);
+    
+    // Walk thresholds from the longest queries down; only a strict saving
+    // switches bidirectional search on
+    long long saving = 0;
+    long long best_saving = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        saving += queries[i].one_sided - queries[i].two_sided;
+        if (i > 0 && queries[i - 1].distance == queries[i].distance) continue;
+        if (saving > best_saving) {
+            best_saving = saving;
+            bidirectional_threshold = queries[i].distance;
+        }
+    }
+    return bidirectional_threshold;
+}
+
+// ===== Path to Nearest Survivor =====
+
+#if MAX_SURVIVORS > 64
+#error "Survivor target masks are 64 bits wide"
+#endif
+
+// One breadth-first search from 'start' that stops at the first survivor
+// whose bit is set in 'targets'; that survivor is the nearest by walkable
+// distance. Unit step costs make Dijkstra a plain FIFO expansion.
+Path* find_path_to_any_survivor(const Grid* grid, Coordinate start,
+                                uint64_t targets, SearchContext* ctx,
+                                int* survivor_found) {
+    if (survivor_found) *survivor_found = -1;
+    if (!targets || !is_valid_coordinate(grid, start)) return NULL;
+    
+    if (!ctx || ctx->num_cells != grid->total_cells) {
+        ctx = default_search_context(grid);
+    }
+    begin_search(ctx);
+    
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    
+    int* queue = ctx->queue_items;
+    int head = 0;
+    int tail = 0;
+    int start_cell = cell_index(grid, start);
+    queue[tail++] = start_cell;
+    ctx->parent[start_cell] = -1;
+    set_search_state(ctx, start_cell, SEARCH_CLOSED);
+    
+    while (head < tail) {
+        int current = queue[head++];
+        ctx->expansions++;
+        
+        int survivor = grid->survivor_map[current];
+        if (survivor >= 0 && (targets & (1ULL << survivor))) {
+            if (survivor_found) *survivor_found = survivor;
+            Path* path = build_path_from_parents(grid, ctx->parent, current);
+            path->collision_count = check_path_collisions(path, grid);
+            return path;
+        }
+        
+        unsigned char mask = grid->neighbor_mask[current];
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(mask & (1 << d))) continue;
+            
+            int next = current + offsets[d];
+            if (search_state(ctx, next) != SEARCH_UNSEEN) continue;
+            
+            ctx->parent[next] = current;
+            set_search_state(ctx, next, SEARCH_CLOSED);
+            queue[tail++] = next;
+        }
+    }
+    
+    return NULL;
+}
+
+Path* find_path_to_nearest_survivor(const Grid* grid, Coordinate start, 
+                                     const int* visited_survivors,
+                                     SearchContext* ctx) {
+    uint64_t targets = 0;
+    for (int i = 0; i < grid->num_survivors; i++) {
+        if (visited_survivors && visited_survivors[i]) continue;
+        if (!cells_connected(grid, start, grid->survivors[i])) continue;
+        targets |= 1ULL << i;
+    }
+    
+    if (use_hierarchy(grid)) {
+        return hpa_path_to_nearest_survivor(grid, start, targets, ctx, NULL);
+    }
+    return find_path_to_any_survivor(grid, start, targets, ctx, NULL);
+}
+
+// ===== Random Path Generation =====
+
+Path* generate_random_path(const Grid* grid, int max_length) {
+    Path* path = create_path(max_length);
+    Coordinate current = grid->start;
+    add_coordinate_to_path(path, current);
+    
+    for (int i = 0; i < max_length && path->length < max_length; i++) {
+        Coordinate neighbors[6];
+        int neighbor_count = get_neighbors(grid, current, neighbors);
+        
+        if (neighbor_count == 0) break;
+        
+        int attempts = 0;
+        Coordinate next = current;
+        while (attempts < 10) {
+            int rand_idx = random_int(0, neighbor_count - 1);
+            next = neighbors[rand_idx];
+            
+            if (is_walkable(grid, next)) {
+                break;
+            }
+            attempts++;
+        }
+        
+        if (!coordinates_equal(next, current)) {
+            add_coordinate_to_path(path, next);
+            current = next;
+        } else {
+            break;
+        }
+    }
+    
+    path->collision_count = check_path_collisions(path, grid);
+    path->survivors_reached = count_survivors_in_path(path, grid);
+    
+    return path;
+}
+
+// ===== Greedy Path Generation =====
+
+// Next greedy segment from survivor/start 'current' using the distance tables
+static Path* greedy_segment_from_table(const Grid* grid, const DistanceTable* table,
+                                       int current, const int* visited, int* nearest) {
+    int best_distance = 0;
+    *nearest = -1;
+    for (int i = 0; i < grid->num_survivors; i++) {
+        if (visited[i]) continue;
+        int dist = source_distance(table, current, i);
+        if (dist > 0 && (*nearest < 0 || dist < best_distance)) {
+            best_distance = dist;
+            *nearest = i;
+        }
+    }
+    if (*nearest < 0) return NULL;
+    
+    Coordinate from = current == table->start_source ? grid->start : grid->survivors[current];
+    return path_to_source(grid, table, from, *nearest);
+}
+
+Path* generate_greedy_path(const Grid* grid) {
+    int hierarchical = use_hierarchy(grid);
+    const DistanceTable* table = hierarchical ? NULL : get_distance_table(grid);
+    Path* path = create_path(100);
+    add_coordinate_to_path(path, grid->start);
+    
+    int* visited = (int*)calloc(grid->num_survivors, sizeof(int));
+    uint64_t targets = 0;
+    for (int i = 0; i < grid->num_survivors; i++) {
+        if (is_survivor_reachable(grid, i)) targets |= 1ULL << i;
+    }
+    int current = hierarchical ? -1 : table->start_source;
+    
+    // Nearest unvisited survivor: table lookup and field walk, or one
+    // abstract-graph search on the cluster hierarchy
+    for (;;) {
+        int nearest = -1;
+        Path* segment = hierarchical
+            ? hpa_path_to_nearest_survivor(grid, path->coordinates[path->length - 1],
+                                           targets, NULL, &nearest)
+            : greedy_segment_from_table(grid, table, current, visited, &nearest);
+        if (!segment || nearest < 0) {
+            free_path(segment);
+            break;
+        }
+        
+        // Survivors passed on the way count as visited too
+        for (int i = 1; i < segment->length; i++) {
+            add_coordinate_to_path(path, segment->coordinates[i]);
+            int passed = get_survivor_at(grid, segment->coordinates[i]);
+            if (passed >= 0) {
+                visited[passed] = 1;
+                targets &= ~(1ULL << passed);
+            }
+        }
+        free_path(segment);
+        
+        visited[nearest] = 1;
+        targets &= ~(1ULL << nearest);
+        current = nearest;
+        
+        if (path->length > MAX_PATH_LENGTH) break;
+    }
+    
+    free(visited);
+    
+    path->collision_count = check_path_collisions(path, grid);
+    path->survivors_reached = count_survivors_in_path(path, grid);
+    
+    return path;
+}
+
+// ===== Population Generation =====
+
+// Slots [0, count) of the initial population hold greedy tours, the
+// rest random walks
+int initial_greedy_count(int population_size) {
+    int greedy_count = population_size / 10;
+    return greedy_count < 1 ? 1 : greedy_count;
+}
+
+Path** generate_initial_population(const Grid* grid, const Config* config, int* pop_size) {
+    int target_size = config->population_size;
+    Path** population = (Path**)safe_malloc(target_size * sizeof(Path*));
+    
+    int generated = 0;
+    int greedy_count = initial_greedy_count(target_size);
+    
+    for (int i = 0; i < greedy_count && generated < target_size; i++) {
+        population[generated++] = generate_greedy_path(grid);
+    }
+    
+    // Same per-slot streams as the worker pool's version
+    while (generated < target_size) {
+        seed_random(config->seed, rng_stream_id(RNG_DOMAIN_INITIAL, 0, (uint32_t)generated));
+        int path_length = random_int(20, MAX_PATH_LENGTH / 2);
+        population[generated++] = generate_random_path(grid, path_length);
+    }
+    
+    *pop_size = generated;
+    return population;
+}
+
+// ===== Path Utilities =====
+
+void print_path(const Path* path) {
+    if (!path) {
+        printf("Path is NULL\n");
+        return;
+    }
+    
+    printf("Path (length=%d, survivors=%d, collisions=%d, fitness=%.2f):\n",
+           path->length, path->survivors_reached, path->collision_count, path->fitness);
+    
+    for (int i = 0; i < path->length && i < 20; i++) {
+        printf("  [%d] (%d, %d, %d)\n", i,
+               path->coordinates[i].x,
+               path->coordinates[i].y,
+               path->coordinates[i].z);
+    }
+    
+    if (path->length > 20) {
+        printf("  ... (%d more coordinates)\n", path->length - 20);
+    }
+}
+
+void save_path_to_file(const Path* path, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        warning("Could not save path to file");
+        return;
+    }
+    
+    fprintf(file, "Path Length: %d\n", path->length);
+    fprintf(file, "Survivors Reached: %d\n", path->survivors_reached);
+    fprintf(file, "Collisions: %d\n", path->collision_count);
+    fprintf(file, "Fitness: %.2f\n\n", path->fitness);
+    
+    fprintf(file, "Coordinates:\n");
+    for (int i = 0; i < path->length; i++) {
+        fprintf(file, "%d: (%d, %d, %d)\n", i,
+                path->coordinates[i].x,
+                path->coordinates[i].y,
+                path->coordinates[i].z);
+    }
+    
+    fclose(file);
+}
+
+float calculate_path_length_euclidean(const Path* path) {
+    float total = 0.0f;
+    for (int i = 1; i < path->length; i++) {
+        total += distance_3d(path->coordinates[i-1], path->coordinates[i]);
+    }
+    return total;
+}
+
+int calculate_path_length_manhattan(const Path* path) {
+    int total = 0;
+    for (int i = 1; i < path->length; i++) {
+        total += manhattan_distance(path->coordinates[i-1], path->coordinates[i]);
+    }
+    return total;
+}
+
+int compare_paths_by_fitness(const void* a, const void* b) {
+    Path* path_a = *(Path**)a;
+    Path* path_b = *(Path**)b;
+    
+    if (path_a->fitness > path_b->fitness) return -1;
+    if (path_a->fitness < path_b->fitness) return 1;
+    return 0;
+}
+
+static inline void swap_paths(Path** population, int i, int j) {
+    Path* temp = population[i];
+    population[i] = population[j];
+    population[j] = temp;
+}
+
+// Quickselect (median-of-three pivot, Hoare partition) down to the k-th
+// best, then a qsort of the k in front
+void select_best_paths(Path** population, int pop_size, int k) {
+    if (!population || pop_size <= 1 || k <= 0) return;
+    if (k > pop_size) k = pop_size;
+    
+    int lo = 0;
+    int hi = pop_size - 1;
+    while (k < pop_size && hi > lo) {
+        int mid = lo + (hi - lo) / 2;
+        if (population[mid]->fitness > population[lo]->fitness) swap_paths(population, lo, mid);
+        if (population[hi]->fitness > population[lo]->fitness) swap_paths(population, lo, hi);
+        if (population[hi]->fitness > population[mid]->fitness) swap_paths(population, mid, hi);
+        float pivot = population[mid]->fitness;
+        
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (population[i]->fitness > pivot) i++;
+            while (population[j]->fitness < pivot) j--;
+            if (i <= j) {
+                swap_paths(population, i, j);
+                i++;
+                j--;
+            }
+        }
+        // [lo, j] >= pivot >= [i, hi]; keep the side holding index k - 1
+        if (k - 1 <= j) {
+            hi = j;
+        } else if (k - 1 >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    
+    qsort(population, k, sizeof(Path*), compare_paths_by_fitness);
+}
@@ -1,76 +1,157 @@
-#ifndef PATH_GENERATOR_H
-#define PATH_GENERATOR_H
-
-#include "utilities.h"
-#include "grid_environment.h"
-
-// ===== Path Structure =====
-
-typedef struct {
-    Coordinate* coordinates;  // Array of coordinates in the path
-    int length;              // Number of coordinates in path
-    int capacity;            // Allocated capacity
-    int survivors_reached;   // Number of survivors reached
-    int* survivors_visited;  // Array of visited survivor indices
-    float fitness;           // Fitness score (calculated later)
-    int collision_count;     // Number of collisions/obstacles hit
-} Path;
-
-// ===== A* Node Structure (for internal use) =====
-
-typedef struct AStarNode {
-    Coordinate position;
-    float g_cost;           // Cost from start to this node
-    float h_cost;           // Heuristic cost to goal
-    float f_cost;           // Total cost (g + h)
-    struct AStarNode* parent;
-    int is_closed;
-} AStarNode;
-
-// ===== Function Prototypes =====
-
-// Path creation and destruction
-Path* create_path(int initial_capacity);
-void free_path(Path* path);
-Path* clone_path(const Path* path);
-
-// Path operations
-void add_coordinate_to_path(Path* path, Coordinate coord);
-void remove_last_coordinate(Path* path);
-void clear_path(Path* path);
-int path_contains_coordinate(const Path* path, Coordinate coord);
-
-// Path validation
-int is_valid_path(const Path* path, const Grid* grid);
-int check_path_collisions(const Path* path, const Grid* grid);
-int count_survivors_in_path(const Path* path, const Grid* grid);
-
-// A* Pathfinding
-Path* find_path_astar(const Grid* grid, Coordinate start, Coordinate goal);
-Path* find_path_to_nearest_survivor(const Grid* grid, Coordinate start, 
-                                     const int* visited_survivors);
-
-// Path connectivity (NEW - for crossover validation)
-Path* connect_coordinates(const Grid* grid, Coordinate from, Coordinate to);
-int are_coordinates_adjacent(Coordinate c1, Coordinate c2);
-
-// Population generation
-Path** generate_initial_population(const Grid* grid, const Config* config, int* pop_size);
-Path* generate_random_path(const Grid* grid, int max_length);
-Path* generate_greedy_path(const Grid* grid);
-
-// Path utilities
-void print_path(const Path* path);
-void save_path_to_file(const Path* path, const char* filename);
-float calculate_path_length_euclidean(const Path* path);
-int calculate_path_length_manhattan(const Path* path);
-
-// Path comparison
-int compare_paths_by_fitness(const void* a, const void* b);
-
-// Heuristic functions
-float heuristic_manhattan(Coordinate a, Coordinate b);
-float heuristic_euclidean(Coordinate a, Coordinate b);
-float heuristic_3d(Coordinate a, Coordinate b);
-
-#endif // PATH_GENERATOR_H
+#ifndef PATH_GENERATOR_H
+#define PATH_GENERATOR_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+
+// ===== Path Structure =====
+
+// Immutable, reference-counted coordinate buffer. share_path() makes a
+// copy that points at its source's cells; the first write to either one
+// (make_path_writable, reserve_path_capacity) gives it a private buffer.
+typedef struct PathBody {
+    int refcount;
+    int capacity;
+    Coordinate coordinates[];
+} PathBody;
+
+typedef struct {
+    Coordinate* coordinates;  // Array of coordinates in the path
+    int length;              // Number of coordinates in path
+    int capacity;            // Allocated capacity
+    int survivors_reached;   // Number of survivors reached
+    int* survivors_visited;  // Array of visited survivor indices
+    float fitness;           // Fitness score (calculated later)
+    int collision_count;     // Number of collisions/obstacles hit
+    struct PathArena* arena; // Owning generation arena (NULL = heap, see path_arena.h)
+    PathBody* body;          // Shared cells (copy-on-write), NULL = own buffer
+} Path;
+
+// ===== A* Search Settings =====
+
+// Open-list implementation used by find_path_astar()
+typedef enum {
+    ASTAR_QUEUE_HEAP = 0,    // Indexed binary heap, heuristic_3d
+    ASTAR_QUEUE_BUCKET = 1   // Dial bucket queue, integer Manhattan heuristic
+} AStarQueueType;
+
+// Search used by connect_coordinates()
+typedef enum {
+    PATHFINDER_ASTAR = 0,    // A* over every neighbor
+    PATHFINDER_JPS = 1,      // 6-connected jump point search
+    PATHFINDER_HPA = 2       // Hierarchical search over floor clusters
+} PathfinderType;
+
+// Per-cell search state
+#define SEARCH_UNSEEN 0
+#define SEARCH_OPEN 1
+#define SEARCH_CLOSED 2
+
+// Reusable search workspace, sized to the grid and allocated once.
+// A cell's g/f/parent/state are only valid when stamp[cell] equals the
+// current generation, so starting a new search is O(1).
+typedef struct {
+    int num_cells;
+    unsigned int generation;
+    long long expansions;    // Nodes popped, summed over all searches
+    unsigned int* stamp;
+    float* g;
+    float* f;
+    int* parent;
+    unsigned char* state;
+    int* queue_items;        // Heap slots
+    int* queue_position;     // Heap position / bucket next link
+    int* queue_prev;         // Bucket prev link
+    int* queue_key;          // Bucket integer key
+    int* backward_links;     // Bidirectional A*: backward queue next/prev/key
+                             // (3 x num_cells), allocated on first use
+} SearchContext;
+
+// Start a new search: invalidates every cell by advancing the generation
+static inline void begin_search(SearchContext* ctx) {
+    ctx->generation++;
+    if (ctx->generation == 0) {
+        memset(ctx->stamp, 0, ctx->num_cells * sizeof(unsigned int));
+        ctx->generation = 1;
+    }
+}
+
+static inline unsigned char search_state(const SearchContext* ctx, int cell) {
+    return ctx->stamp[cell] == ctx->generation ? ctx->state[cell] : SEARCH_UNSEEN;
+}
+
+static inline void set_search_state(SearchContext* ctx, int cell, unsigned char state) {
+    ctx->stamp[cell] = ctx->generation;
+    ctx->state[cell] = state;
+}
+
+// ===== Function Prototypes =====
+
+// Path creation and destruction
+Path* create_path(int initial_capacity);
+void free_path(Path* path);
+Path* clone_path(const Path* path);
+Path* share_path(Path* path);        // O(1) copy; 'path' gives up its buffer to a body once
+void make_path_writable(Path* path); // Call before writing cells in place
+void release_path_body(PathBody* body);
+
+// Path operations
+void reserve_path_capacity(Path* path, int capacity);
+void add_coordinate_to_path(Path* path, Coordinate coord);
+
+// Path validation
+int is_valid_path(const Path* path, const Grid* grid);
+int check_path_collisions(const Path* path, const Grid* grid);
+int count_survivors_in_path(const Path* path, const Grid* grid);
+
+// A* Pathfinding
+// (ctx may be NULL: the calling thread's default context is used)
+void configure_pathfinding(const Config* config);
+SearchContext* create_search_context(const Grid* grid);
+void free_search_context(SearchContext* ctx);
+SearchContext* default_search_context(const Grid* grid);
+Path* find_path_astar(const Grid* grid, Coordinate start, Coordinate goal,
+                      SearchContext* ctx);
+Path* find_path_bidirectional(const Grid* grid, Coordinate start, Coordinate goal,
+                              SearchContext* ctx);
+// BIDIRECTIONAL_THRESHOLD=0: time seeded sample connectors on 'grid' in
+// node expansions and use bidirectional A* from the Manhattan distance
+// where it starts expanding fewer. Call after configure_pathfinding() and
+// before workers fork. Returns the threshold, -1 = never worth it.
+int calibrate_bidirectional_threshold(const Grid* grid);
+Path* find_path_to_nearest_survivor(const Grid* grid, Coordinate start, 
+                                     const int* visited_survivors,
+                                     SearchContext* ctx);
+Path* find_path_to_any_survivor(const Grid* grid, Coordinate start,
+                                uint64_t targets, SearchContext* ctx,
+                                int* survivor_found);
+
+// Path connectivity (NEW - for crossover validation)
+Path* connect_coordinates(const Grid* grid, Coordinate from, Coordinate to,
+                          SearchContext* ctx);
+int are_coordinates_adjacent(Coordinate c1, Coordinate c2);
+
+// Population generation
+Path** generate_initial_population(const Grid* grid, const Config* config, int* pop_size);
+int initial_greedy_count(int population_size);
+Path* generate_random_path(const Grid* grid, int max_length);
+Path* generate_greedy_path(const Grid* grid);
+
+// Path utilities
+void print_path(const Path* path);
+void save_path_to_file(const Path* path, const char* filename);
+float calculate_path_length_euclidean(const Path* path);
+int calculate_path_length_manhattan(const Path* path);
+
+// Path comparison
+int compare_paths_by_fitness(const void* a, const void* b);
+// Move the k fittest paths to population[0..k), best first; the rest are
+// left unordered. O(n + k log k) instead of a full sort.
+void select_best_paths(Path** population, int pop_size, int k);
+
+// Heuristic functions
+float heuristic_manhattan(Coordinate a, Coordinate b);
+float heuristic_euclidean(Coordinate a, Coordinate b);
+float heuristic_3d(Coordinate a, Coordinate b);
+
+#endif // PATH_GENERATOR_H
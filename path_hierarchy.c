@@ -0,0 +1,736 @@
+#include "path_hierarchy.h"
+#include "search_queue.h"
+#include <float.h>
+
+static int hierarchy_cluster_size = DEFAULT_CLUSTER_SIZE;
+
+void configure_hierarchy(const Config* config) {
+    hierarchy_cluster_size = config->hpa_cluster_size > 1 ? config->hpa_cluster_size
+                                                          : DEFAULT_CLUSTER_SIZE;
+}
+
+// ===== Cluster Geometry =====
+
+typedef struct {
+    int x0, x1;              // [x0, x1)
+    int y0, y1;              // [y0, y1)
+    int z;
+} ClusterBox;
+
+static inline int is_open_cell(const Grid* grid, int cell) {
+    return grid->cell_data[cell] != CELL_OBSTACLE;
+}
+
+static int cluster_of(const PathHierarchy* h, const Grid* grid, int cell) {
+    Coordinate c = cell_coordinate(grid, cell);
+    int cx = c.x / h->cluster_size;
+    int cy = c.y / h->cluster_size;
+    return (cx * h->clusters_y + cy) * grid->size_z + c.z;
+}
+
+static ClusterBox cluster_box(const PathHierarchy* h, const Grid* grid, int cluster) {
+    ClusterBox box;
+    box.z = cluster % grid->size_z;
+    int column = cluster / grid->size_z;
+    box.x0 = (column / h->clusters_y) * h->cluster_size;
+    box.y0 = (column % h->clusters_y) * h->cluster_size;
+    box.x1 = box.x0 + h->cluster_size < grid->size_x ? box.x0 + h->cluster_size : grid->size_x;
+    box.y1 = box.y0 + h->cluster_size < grid->size_y ? box.y0 + h->cluster_size : grid->size_y;
+    return box;
+}
+
+static inline int local_index(const ClusterBox* box, Coordinate c) {
+    return (c.x - box->x0) * (box->y1 - box->y0) + (c.y - box->y0);
+}
+
+// ===== Cluster-Local BFS =====
+// Workspace sized to one cluster; per thread like the search contexts
+
+typedef struct {
+    int capacity;
+    int* dist;               // Local index -> hops from the BFS origin (-1 = unreached)
+    int* next;               // Local index -> local index one step closer to the origin
+    int* queue;              // Cell indices
+} ClusterWorkspace;
+
+static _Thread_local ClusterWorkspace cluster_ws = {0, NULL, NULL, NULL};
+
+static ClusterWorkspace* get_cluster_workspace(int cluster_size) {
+    int needed = cluster_size * cluster_size;
+    if (cluster_ws.capacity < needed) {
+        free(cluster_ws.dist);
+        free(cluster_ws.next);
+        free(cluster_ws.queue);
+        cluster_ws.dist = (int*)safe_malloc(needed * sizeof(int));
+        cluster_ws.next = (int*)safe_malloc(needed * sizeof(int));
+        cluster_ws.queue = (int*)safe_malloc(needed * sizeof(int));
+        cluster_ws.capacity = needed;
+    }
+    return &cluster_ws;
+}
+
+// BFS from 'origin' over the open cells of one cluster (in-floor moves
+// only). Returns the number of cells expanded.
+static int cluster_bfs(const Grid* grid, const ClusterBox* box, int origin,
+                       const int* offsets, ClusterWorkspace* ws) {
+    int area = (box->x1 - box->x0) * (box->y1 - box->y0);
+    for (int i = 0; i < area; i++) ws->dist[i] = -1;
+
+    int origin_local = local_index(box, cell_coordinate(grid, origin));
+    ws->dist[origin_local] = 0;
+    ws->next[origin_local] = -1;
+
+    int head = 0;
+    int tail = 0;
+    ws->queue[tail++] = origin;
+
+    while (head < tail) {
+        int cell = ws->queue[head++];
+        Coordinate c = cell_coordinate(grid, cell);
+        int local = local_index(box, c);
+        unsigned char mask = grid->neighbor_mask[cell];
+
+        for (int d = 0; d < DIR_POS_Z; d++) {
+            if (!(mask & (1 << d))) continue;
+            int nx = c.x + DIR_DX[d];
+            int ny = c.y + DIR_DY[d];
+            if (nx < box->x0 || nx >= box->x1 || ny < box->y0 || ny >= box->y1) continue;
+
+            int next_local = (nx - box->x0) * (box->y1 - box->y0) + (ny - box->y0);
+            if (ws->dist[next_local] >= 0) continue;
+
+            ws->dist[next_local] = ws->dist[local] + 1;
+            ws->next[next_local] = local;
+            ws->queue[tail++] = cell + offsets[d];
+        }
+    }
+    return tail;
+}
+
+static int local_to_cell(const Grid* grid, const ClusterBox* box, int local) {
+    int height = box->y1 - box->y0;
+    return cell_index(grid, create_coordinate(box->x0 + local / height,
+                                              box->y0 + local % height, box->z));
+}
+
+// Append the in-cluster shortest path from 'from' to 'to' (excluding 'from')
+static int append_cluster_path(Path* path, const Grid* grid, const PathHierarchy* h,
+                               int from, int to, const int* offsets) {
+    ClusterBox box = cluster_box(h, grid, cluster_of(h, grid, to));
+    ClusterWorkspace* ws = get_cluster_workspace(h->cluster_size);
+    int expanded = cluster_bfs(grid, &box, to, offsets, ws);
+
+    int local = local_index(&box, cell_coordinate(grid, from));
+    if (ws->dist[local] < 0) return expanded;
+
+    for (local = ws->next[local]; local >= 0; local = ws->next[local]) {
+        add_coordinate_to_path(path, cell_coordinate(grid, local_to_cell(grid, &box, local)));
+    }
+    return expanded;
+}
+
+// ===== Construction =====
+
+typedef struct {
+    int from;
+    int to;
+    int cost;
+} EdgeBuild;
+
+typedef struct {
+    PathHierarchy* h;
+    int* node_at;            // Cell -> node index (-1 = none), build time only
+    int node_capacity;
+    EdgeBuild* edges;
+    int edge_count;
+    int edge_capacity;
+} HierarchyBuilder;
+
+static int add_node(HierarchyBuilder* b, const Grid* grid, int cell, int survivor) {
+    int existing = b->node_at[cell];
+    if (existing >= 0) {
+        if (survivor >= 0) b->h->nodes[existing].survivor = survivor;
+        return existing;
+    }
+
+    PathHierarchy* h = b->h;
+    if (h->num_nodes == b->node_capacity) {
+        b->node_capacity = b->node_capacity ? b->node_capacity * 2 : 256;
+        h->nodes = (HierarchyNode*)realloc(h->nodes, b->node_capacity * sizeof(HierarchyNode));
+        if (!h->nodes) error_exit("Memory allocation failed");
+    }
+
+    HierarchyNode* node = &h->nodes[h->num_nodes];
+    node->cell = cell;
+    node->cluster = cluster_of(h, grid, cell);
+    node->survivor = survivor;
+    node->first_edge = 0;
+    node->edge_count = 0;
+    b->node_at[cell] = h->num_nodes;
+    return h->num_nodes++;
+}
+
+static void add_edge(HierarchyBuilder* b, int from, int to, int cost) {
+    if (b->edge_count == b->edge_capacity) {
+        b->edge_capacity = b->edge_capacity ? b->edge_capacity * 2 : 1024;
+        b->edges = (EdgeBuild*)realloc(b->edges, b->edge_capacity * sizeof(EdgeBuild));
+        if (!b->edges) error_exit("Memory allocation failed");
+    }
+    b->edges[b->edge_count].from = from;
+    b->edges[b->edge_count].to = to;
+    b->edges[b->edge_count].cost = cost;
+    b->edge_count++;
+}
+
+static void add_portal(HierarchyBuilder* b, const Grid* grid, int cell_a, int cell_b) {
+    int a = add_node(b, grid, cell_a, -1);
+    int n = add_node(b, grid, cell_b, -1);
+    add_edge(b, a, n, 1);
+    add_edge(b, n, a, 1);
+}
+
+// One portal in the middle of every maximal open run along the border
+// between x-columns bx and bx+1 (axis 0) or y-rows by and by+1 (axis 1)
+static void add_border_portals(HierarchyBuilder* b, const Grid* grid, int axis,
+                               int border, int z) {
+    int cs = b->h->cluster_size;
+    int span = axis == 0 ? grid->size_y : grid->size_x;
+    int run_start = -1;
+
+    for (int t = 0; t <= span; t++) {
+        int open = 0;
+        if (t < span) {
+            Coordinate c = axis == 0 ? create_coordinate(border, t, z)
+                                     : create_coordinate(t, border, z);
+            int cell = cell_index(grid, c);
+            open = is_open_cell(grid, cell) &&
+                   (grid->neighbor_mask[cell] & (1 << (axis == 0 ? DIR_POS_X : DIR_POS_Y)));
+        }
+
+        // Runs end at walls and at cluster boundaries along the border
+        int boundary = (t < span && t % cs == 0);
+        if (run_start >= 0 && (!open || boundary)) {
+            int mid = (run_start + t - 1) / 2;
+            Coordinate c = axis == 0 ? create_coordinate(border, mid, z)
+                                     : create_coordinate(mid, border, z);
+            Coordinate across = axis == 0 ? create_coordinate(border + 1, mid, z)
+                                          : create_coordinate(mid, border + 1, z);
+            add_portal(b, grid, cell_index(grid, c), cell_index(grid, across));
+            run_start = -1;
+        }
+        if (open && run_start < 0) run_start = t;
+    }
+}
+
+// One stair/shaft portal per connected patch of cells open on both floor
+// z and z+1 within a cluster footprint, placed nearest the patch centre
+static void add_shaft_portals(HierarchyBuilder* b, const Grid* grid, const ClusterBox* box,
+                              unsigned char* seen, int* patch) {
+    int height = box->y1 - box->y0;
+    int area = (box->x1 - box->x0) * height;
+    memset(seen, 0, area);
+
+    for (int start = 0; start < area; start++) {
+        if (seen[start]) continue;
+        int cell = local_to_cell(grid, box, start);
+        if (!is_open_cell(grid, cell) || !(grid->neighbor_mask[cell] & (1 << DIR_POS_Z))) continue;
+
+        // Flood the patch (in-floor 4-neighbourhood)
+        int count = 0;
+        long sum_x = 0, sum_y = 0;
+        patch[count++] = start;
+        seen[start] = 1;
+        for (int i = 0; i < count; i++) {
+            int local = patch[i];
+            int lx = local / height;
+            int ly = local % height;
+            sum_x += lx;
+            sum_y += ly;
+
+            for (int d = 0; d < DIR_POS_Z; d++) {
+                int nx = lx + DIR_DX[d];
+                int ny = ly + DIR_DY[d];
+                if (nx < 0 || nx >= box->x1 - box->x0 || ny < 0 || ny >= height) continue;
+                int next = nx * height + ny;
+                if (seen[next]) continue;
+                int next_cell = local_to_cell(grid, box, next);
+                if (!is_open_cell(grid, next_cell) ||
+                    !(grid->neighbor_mask[next_cell] & (1 << DIR_POS_Z))) continue;
+                seen[next] = 1;
+                patch[count++] = next;
+            }
+        }
+
+        int best = patch[0];
+        long best_score = -1;
+        for (int i = 0; i < count; i++) {
+            long dx = (long)(patch[i] / height) * count - sum_x;
+            long dy = (long)(patch[i] % height) * count - sum_y;
+            long score = labs(dx) + labs(dy);
+            if (best_score < 0 || score < best_score) {
+                best_score = score;
+                best = patch[i];
+            }
+        }
+
+        int lower = local_to_cell(grid, box, best);
+        add_portal(b, grid, lower, lower + 1);
+    }
+}
+
+// Copy a clean cluster's in-cluster edges from the previous hierarchy.
+// Fails when a neighbouring change moved, added or dropped one of its
+// portals, since the node set no longer matches.
+static int reuse_cluster_edges(HierarchyBuilder* b, const PathHierarchy* previous,
+                               int cluster) {
+    const PathHierarchy* h = b->h;
+    int first = h->cluster_first[cluster];
+    int count = h->cluster_first[cluster + 1] - first;
+    int old_first = previous->cluster_first[cluster];
+    if (previous->cluster_first[cluster + 1] - old_first != count) return 0;
+
+    for (int i = 0; i < count; i++) {
+        if (previous->nodes[previous->cluster_nodes[old_first + i]].cell !=
+            h->nodes[h->cluster_nodes[first + i]].cell) return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const HierarchyNode* node = &previous->nodes[previous->cluster_nodes[old_first + i]];
+        for (int e = 0; e < node->edge_count; e++) {
+            const HierarchyEdge* edge = &previous->edges[node->first_edge + e];
+            const HierarchyNode* target = &previous->nodes[edge->target];
+            if (target->cluster != cluster) continue;   // Portal edge, already re-added
+            add_edge(b, b->node_at[node->cell], b->node_at[target->cell], edge->cost);
+        }
+    }
+    return 1;
+}
+
+// Full build when 'previous' is NULL. Otherwise clusters not flagged in
+// 'dirty' keep the in-cluster edges of 'previous' when their nodes are
+// unchanged; portals are always re-scanned (a linear pass over the
+// borders and floors), so only the BFS linking work is saved.
+static PathHierarchy* build_hierarchy(const Grid* grid, int cluster_size,
+                                      const PathHierarchy* previous,
+                                      const unsigned char* dirty) {
+    PathHierarchy* h = (PathHierarchy*)safe_calloc(1, sizeof(PathHierarchy));
+    h->cluster_size = cluster_size;
+    h->clusters_x = (grid->size_x + cluster_size - 1) / cluster_size;
+    h->clusters_y = (grid->size_y + cluster_size - 1) / cluster_size;
+    h->num_clusters = h->clusters_x * h->clusters_y * grid->size_z;
+    h->grid_version = grid->version;
+    h->num_survivors = grid->num_survivors;
+
+    HierarchyBuilder b = {h, NULL, 0, NULL, 0, 0};
+    b.node_at = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    memset(b.node_at, -1, grid->total_cells * sizeof(int));
+
+    // Permanent endpoints
+    add_node(&b, grid, cell_index(grid, grid->start), -1);
+    for (int s = 0; s < grid->num_survivors; s++) {
+        add_node(&b, grid, cell_index(grid, grid->survivors[s]), s);
+    }
+
+    // Portals between clusters on the same floor and between floors
+    for (int z = 0; z < grid->size_z; z++) {
+        for (int cx = 1; cx < h->clusters_x; cx++) {
+            add_border_portals(&b, grid, 0, cx * cluster_size - 1, z);
+        }
+        for (int cy = 1; cy < h->clusters_y; cy++) {
+            add_border_portals(&b, grid, 1, cy * cluster_size - 1, z);
+        }
+    }
+
+    int area = cluster_size * cluster_size;
+    unsigned char* seen = (unsigned char*)safe_malloc(area);
+    int* patch = (int*)safe_malloc(area * sizeof(int));
+    for (int c = 0; c < h->num_clusters; c++) {
+        ClusterBox box = cluster_box(h, grid, c);
+        if (box.z + 1 < grid->size_z) {
+            add_shaft_portals(&b, grid, &box, seen, patch);
+        }
+    }
+    free(seen);
+    free(patch);
+
+    // Group nodes by cluster
+    h->cluster_first = (int*)safe_calloc(h->num_clusters + 1, sizeof(int));
+    h->cluster_nodes = (int*)safe_malloc((h->num_nodes > 0 ? h->num_nodes : 1) * sizeof(int));
+    for (int n = 0; n < h->num_nodes; n++) {
+        h->cluster_first[h->nodes[n].cluster + 1]++;
+    }
+    for (int c = 0; c < h->num_clusters; c++) {
+        h->cluster_first[c + 1] += h->cluster_first[c];
+    }
+    int* fill = (int*)safe_malloc((h->num_clusters + 1) * sizeof(int));
+    memcpy(fill, h->cluster_first, (h->num_clusters + 1) * sizeof(int));
+    for (int n = 0; n < h->num_nodes; n++) {
+        h->cluster_nodes[fill[h->nodes[n].cluster]++] = n;
+    }
+    free(fill);
+
+    // In-cluster distances between every pair of nodes sharing a cluster
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    ClusterWorkspace* ws = get_cluster_workspace(cluster_size);
+    for (int c = 0; c < h->num_clusters; c++) {
+        int first = h->cluster_first[c];
+        int last = h->cluster_first[c + 1];
+        if (last - first < 2) continue;
+        if (previous && !dirty[c] && reuse_cluster_edges(&b, previous, c)) continue;
+
+        ClusterBox box = cluster_box(h, grid, c);
+        for (int i = first; i < last; i++) {
+            int from = h->cluster_nodes[i];
+            cluster_bfs(grid, &box, h->nodes[from].cell, offsets, ws);
+            for (int j = first; j < last; j++) {
+                int to = h->cluster_nodes[j];
+                if (to == from) continue;
+                int d = ws->dist[local_index(&box, cell_coordinate(grid, h->nodes[to].cell))];
+                if (d > 0) add_edge(&b, from, to, d);
+            }
+        }
+    }
+    free(b.node_at);
+
+    // Edges grouped by source node
+    h->num_edges = b.edge_count;
+    h->edges = (HierarchyEdge*)safe_malloc((b.edge_count > 0 ? b.edge_count : 1) * sizeof(HierarchyEdge));
+    for (int e = 0; e < b.edge_count; e++) {
+        h->nodes[b.edges[e].from].edge_count++;
+    }
+    int offset = 0;
+    for (int n = 0; n < h->num_nodes; n++) {
+        h->nodes[n].first_edge = offset;
+        offset += h->nodes[n].edge_count;
+        h->nodes[n].edge_count = 0;
+    }
+    for (int e = 0; e < b.edge_count; e++) {
+        HierarchyNode* node = &h->nodes[b.edges[e].from];
+        HierarchyEdge* edge = &h->edges[node->first_edge + node->edge_count++];
+        edge->target = b.edges[e].to;
+        edge->cost = b.edges[e].cost;
+    }
+    free(b.edges);
+
+    return h;
+}
+
+PathHierarchy* build_path_hierarchy(const Grid* grid, int cluster_size) {
+    return build_hierarchy(grid, cluster_size, NULL, NULL);
+}
+
+void free_path_hierarchy(PathHierarchy* hierarchy) {
+    if (!hierarchy) return;
+    free(hierarchy->nodes);
+    free(hierarchy->edges);
+    free(hierarchy->cluster_first);
+    free(hierarchy->cluster_nodes);
+    free(hierarchy);
+}
+
+// Cached on the grid. Collapse batches re-link only the touched clusters
+// (update_path_hierarchy); any other change rebuilds it from scratch.
+const PathHierarchy* get_path_hierarchy(const Grid* grid) {
+    Grid* cache = (Grid*)grid;
+    PathHierarchy* h = cache->hierarchy;
+
+    if (!h || h->grid_version != grid->version || h->num_survivors != grid->num_survivors ||
+        h->cluster_size != hierarchy_cluster_size) {
+        free_path_hierarchy(h);
+        cache->hierarchy = build_path_hierarchy(grid, hierarchy_cluster_size);
+    }
+    return cache->hierarchy;
+}
+
+// Re-link only the clusters holding a changed cell. 'deltas' take the grid
+// from 'base_version' to its current version; a hierarchy built for any
+// other version is left to get_path_hierarchy() to rebuild.
+void update_path_hierarchy(Grid* grid, const CellDelta* deltas, int count, int base_version) {
+    PathHierarchy* h = grid->hierarchy;
+    if (!h || h->grid_version != base_version || h->num_survivors != grid->num_survivors ||
+        h->cluster_size != hierarchy_cluster_size) {
+        return;
+    }
+
+    unsigned char* dirty = (unsigned char*)safe_calloc(h->num_clusters, 1);
+    for (int i = 0; i < count; i++) {
+        dirty[cluster_of(h, grid, cell_index(grid, deltas[i].coord))] = 1;
+    }
+    grid->hierarchy = build_hierarchy(grid, h->cluster_size, h, dirty);
+    free(dirty);
+    free_path_hierarchy(h);
+}
+
+size_t path_hierarchy_bytes(const PathHierarchy* hierarchy) {
+    if (!hierarchy) return 0;
+    return sizeof(PathHierarchy) +
+           (size_t)hierarchy->num_nodes * (sizeof(HierarchyNode) + sizeof(int)) +
+           (size_t)hierarchy->num_edges * sizeof(HierarchyEdge) +
+           (size_t)(hierarchy->num_clusters + 1) * sizeof(int);
+}
+
+// ===== Abstract Search =====
+
+typedef struct {
+    int capacity;
+    unsigned int generation;
+    unsigned int* stamp;     // Node state valid when equal to generation
+    unsigned char* state;
+    float* g;
+    float* f;
+    int* parent;             // -1 = entered from the query start
+    unsigned int* goal_stamp;
+    int* goal_dist;          // In-cluster hops from node to the goal
+    int* heap_items;
+    int* heap_position;
+} AbstractWorkspace;
+
+static _Thread_local AbstractWorkspace abstract_ws = {0};
+
+static AbstractWorkspace* get_abstract_workspace(int num_nodes) {
+    AbstractWorkspace* ws = &abstract_ws;
+    if (ws->capacity < num_nodes) {
+        free(ws->stamp);
+        free(ws->state);
+        free(ws->g);
+        free(ws->f);
+        free(ws->parent);
+        free(ws->goal_stamp);
+        free(ws->goal_dist);
+        free(ws->heap_items);
+        free(ws->heap_position);
+        ws->stamp = (unsigned int*)safe_calloc(num_nodes, sizeof(unsigned int));
+        ws->state = (unsigned char*)safe_malloc(num_nodes);
+        ws->g = (float*)safe_malloc(num_nodes * sizeof(float));
+        ws->f = (float*)safe_malloc(num_nodes * sizeof(float));
+        ws->parent = (int*)safe_malloc(num_nodes * sizeof(int));
+        ws->goal_stamp = (unsigned int*)safe_calloc(num_nodes, sizeof(unsigned int));
+        ws->goal_dist = (int*)safe_malloc(num_nodes * sizeof(int));
+        ws->heap_items = (int*)safe_malloc(num_nodes * sizeof(int));
+        ws->heap_position = (int*)safe_malloc(num_nodes * sizeof(int));
+        ws->capacity = num_nodes;
+        ws->generation = 0;
+    }
+
+    ws->generation++;
+    if (ws->generation == 0) {
+        memset(ws->stamp, 0, ws->capacity * sizeof(unsigned int));
+        memset(ws->goal_stamp, 0, ws->capacity * sizeof(unsigned int));
+        ws->generation = 1;
+    }
+    return ws;
+}
+
+// Search the abstract graph from start_cell, either to goal_cell or (when
+// goal_cell < 0) to the nearest survivor node whose bit is set in targets,
+// then refine the route cluster by cluster.
+static Path* hierarchy_query(const Grid* grid, const PathHierarchy* h, int start_cell,
+                             int goal_cell, uint64_t targets, SearchContext* ctx,
+                             int* survivor_found) {
+    AbstractWorkspace* aw = get_abstract_workspace(h->num_nodes > 0 ? h->num_nodes : 1);
+    ClusterWorkspace* cw = get_cluster_workspace(h->cluster_size);
+    unsigned int gen = aw->generation;
+    long long expanded = 0;
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    Coordinate goal = goal_cell >= 0 ? cell_coordinate(grid, goal_cell) : create_coordinate(0, 0, 0);
+    float best = FLT_MAX;
+    int best_node = -1;
+    int direct = 0;
+
+    // Exit costs: goal cluster nodes -> goal
+    if (goal_cell >= 0) {
+        int c = cluster_of(h, grid, goal_cell);
+        ClusterBox box = cluster_box(h, grid, c);
+        expanded += cluster_bfs(grid, &box, goal_cell, offsets, cw);
+        for (int i = h->cluster_first[c]; i < h->cluster_first[c + 1]; i++) {
+            int n = h->cluster_nodes[i];
+            int d = cw->dist[local_index(&box, cell_coordinate(grid, h->nodes[n].cell))];
+            if (d < 0) continue;
+            aw->goal_stamp[n] = gen;
+            aw->goal_dist[n] = d;
+        }
+    }
+
+    // Entry costs: start -> start cluster nodes (and the goal if it is local)
+    IndexedHeap heap;
+    heap_init(&heap, aw->heap_items, aw->heap_position, aw->f, aw->g);
+    {
+        int c = cluster_of(h, grid, start_cell);
+        ClusterBox box = cluster_box(h, grid, c);
+        expanded += cluster_bfs(grid, &box, start_cell, offsets, cw);
+
+        if (goal_cell >= 0 && cluster_of(h, grid, goal_cell) == c) {
+            int d = cw->dist[local_index(&box, goal)];
+            if (d >= 0) {
+                best = (float)d;
+                direct = 1;
+            }
+        }
+
+        for (int i = h->cluster_first[c]; i < h->cluster_first[c + 1]; i++) {
+            int n = h->cluster_nodes[i];
+            Coordinate pos = cell_coordinate(grid, h->nodes[n].cell);
+            int d = cw->dist[local_index(&box, pos)];
+            if (d < 0) continue;
+            aw->stamp[n] = gen;
+            aw->state[n] = SEARCH_OPEN;
+            aw->g[n] = (float)d;
+            aw->f[n] = d + (goal_cell >= 0 ? heuristic_manhattan(pos, goal) : 0.0f);
+            aw->parent[n] = -1;
+            heap_push(&heap, n);
+        }
+    }
+
+    for (;;) {
+        int n = heap_pop(&heap);
+        if (n < 0 || aw->f[n] >= best) break;
+        expanded++;
+        aw->state[n] = SEARCH_CLOSED;
+
+        if (goal_cell >= 0) {
+            if (aw->goal_stamp[n] == gen && aw->g[n] + aw->goal_dist[n] < best) {
+                best = aw->g[n] + aw->goal_dist[n];
+                best_node = n;
+                direct = 0;
+            }
+        } else if (h->nodes[n].survivor >= 0 && (targets & (1ULL << h->nodes[n].survivor))) {
+            best = aw->g[n];
+            best_node = n;
+            break;
+        }
+
+        const HierarchyNode* node = &h->nodes[n];
+        for (int e = node->first_edge; e < node->first_edge + node->edge_count; e++) {
+            int t = h->edges[e].target;
+            float tentative_g = aw->g[n] + h->edges[e].cost;
+            int seen = (aw->stamp[t] == gen);
+            if (seen && aw->state[t] == SEARCH_CLOSED) continue;
+            if (seen && tentative_g >= aw->g[t]) continue;
+
+            aw->g[t] = tentative_g;
+            aw->f[t] = tentative_g + (goal_cell >= 0 ?
+                       heuristic_manhattan(cell_coordinate(grid, h->nodes[t].cell), goal) : 0.0f);
+            aw->parent[t] = n;
+            if (!seen) {
+                aw->stamp[t] = gen;
+                aw->state[t] = SEARCH_OPEN;
+                heap_push(&heap, t);
+            } else {
+                heap_decrease(&heap, t);
+            }
+        }
+    }
+
+    if (best == FLT_MAX) {
+        if (ctx) ctx->expansions += expanded;
+        return NULL;
+    }
+
+    // Refinement: only the clusters along the abstract route are searched
+    Path* path = create_path((int)best + 1);
+    add_coordinate_to_path(path, cell_coordinate(grid, start_cell));
+    int current = start_cell;
+
+    if (!direct) {
+        int hops = 0;
+        for (int n = best_node; n >= 0; n = aw->parent[n]) hops++;
+        int* route = (int*)safe_malloc(hops * sizeof(int));
+        int i = hops;
+        for (int n = best_node; n >= 0; n = aw->parent[n]) route[--i] = n;
+
+        for (i = 0; i < hops; i++) {
+            int cell = h->nodes[route[i]].cell;
+            if (cell == current) continue;
+            if (cluster_of(h, grid, cell) != cluster_of(h, grid, current)) {
+                add_coordinate_to_path(path, cell_coordinate(grid, cell));   // Portal hop
+            } else {
+                expanded += append_cluster_path(path, grid, h, current, cell, offsets);
+            }
+            current = cell;
+        }
+        free(route);
+
+        if (survivor_found && goal_cell < 0) *survivor_found = h->nodes[best_node].survivor;
+    }
+
+    if (goal_cell >= 0 && current != goal_cell) {
+        expanded += append_cluster_path(path, grid, h, current, goal_cell, offsets);
+    }
+
+    if (ctx) ctx->expansions += expanded;
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
+
+// An obstacle start (a damaged genome) can be left but never entered, so
+// the cluster searches cannot see it: query from each open neighbour and
+// step from the start onto the shortest result
+static Path* hierarchy_query_from(const Grid* grid, const PathHierarchy* h, int start_cell,
+                                  int goal_cell, uint64_t targets, SearchContext* ctx,
+                                  int* survivor_found) {
+    if (grid->cell_data[start_cell] != CELL_OBSTACLE) {
+        return hierarchy_query(grid, h, start_cell, goal_cell, targets, ctx, survivor_found);
+    }
+
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+
+    Path* best = NULL;
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (!(grid->neighbor_mask[start_cell] & (1 << d))) continue;
+        int found = -1;
+        Path* path = hierarchy_query(grid, h, start_cell + offsets[d], goal_cell, targets,
+                                     ctx, &found);
+        if (path && (!best || path->length < best->length)) {
+            free_path(best);
+            best = path;
+            if (survivor_found) *survivor_found = found;
+        } else {
+            free_path(path);
+        }
+    }
+    if (!best) return NULL;
+
+    Path* path = create_path(best->length + 1);
+    add_coordinate_to_path(path, cell_coordinate(grid, start_cell));
+    for (int i = 0; i < best->length; i++) {
+        add_coordinate_to_path(path, best->coordinates[i]);
+    }
+    free_path(best);
+    path->collision_count = check_path_collisions(path, grid);
+    return path;
+}
+
+Path* find_path_hpa(const Grid* grid, Coordinate start, Coordinate goal,
+                    SearchContext* ctx) {
+    if (!is_valid_coordinate(grid, start) || !is_valid_coordinate(grid, goal)) {
+        return NULL;
+    }
+
+    if (is_obstacle(grid, goal) && !is_survivor(grid, goal)) {
+        return NULL;
+    }
+
+    if (!cells_connected(grid, start, goal)) {
+        return NULL;
+    }
+
+    const PathHierarchy* h = get_path_hierarchy(grid);
+    return hierarchy_query_from(grid, h, cell_index(grid, start), cell_index(grid, goal),
+                                0, ctx, NULL);
+}
+
+Path* hpa_path_to_nearest_survivor(const Grid* grid, Coordinate start,
+                                   uint64_t targets, SearchContext* ctx,
+                                   int* survivor_found) {
+    if (survivor_found) *survivor_found = -1;
+    if (!targets || !is_valid_coordinate(grid, start)) return NULL;
+
+    const PathHierarchy* h = get_path_hierarchy(grid);
+    return hierarchy_query_from(grid, h, cell_index(grid, start), -1, targets, ctx,
+                                survivor_found);
+}
@@ -0,0 +1,69 @@
+#ifndef PATH_HIERARCHY_H
+#define PATH_HIERARCHY_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Hierarchical Pathfinding (HPA*) =====
+// Each floor is cut into square clusters. Every maximal open run along a
+// shared cluster border becomes a portal (one node per side, linked by a
+// unit edge), and every connected patch of cells open on two consecutive
+// floors becomes a stair/shaft portal. The start cell and all survivors
+// are permanent nodes. Nodes in the same cluster are linked by their
+// in-cluster BFS distance.
+//
+// Queries search the abstract graph and then refine only the clusters the
+// abstract route passes through, so work grows with route length rather
+// than grid volume. Paths are valid but not always shortest: portals sit
+// mid-run, so routes bend through them (about 9% longer on 30x30x7).
+
+#define DEFAULT_CLUSTER_SIZE 16
+
+typedef struct {
+    int cell;                // Grid cell index
+    int cluster;             // Cluster id
+    int survivor;            // Survivor index, -1 for portals
+    int first_edge;          // Edges are stored grouped by source node
+    int edge_count;
+} HierarchyNode;
+
+typedef struct {
+    int target;
+    int cost;
+} HierarchyEdge;
+
+struct PathHierarchy {
+    int cluster_size;
+    int clusters_x;
+    int clusters_y;
+    int num_clusters;        // clusters_x * clusters_y * size_z
+    int grid_version;        // Grid version the hierarchy was built for
+    int num_survivors;
+
+    HierarchyNode* nodes;
+    int num_nodes;
+    HierarchyEdge* edges;
+    int num_edges;
+
+    int* cluster_first;      // num_clusters + 1 offsets into cluster_nodes
+    int* cluster_nodes;      // Node indices grouped by cluster
+};
+typedef struct PathHierarchy PathHierarchy;
+
+// ===== Construction =====
+void configure_hierarchy(const Config* config);
+PathHierarchy* build_path_hierarchy(const Grid* grid, int cluster_size);
+void free_path_hierarchy(PathHierarchy* hierarchy);
+const PathHierarchy* get_path_hierarchy(const Grid* grid);
+void update_path_hierarchy(Grid* grid, const CellDelta* deltas, int count, int base_version);
+size_t path_hierarchy_bytes(const PathHierarchy* hierarchy);
+
+// ===== Queries =====
+Path* find_path_hpa(const Grid* grid, Coordinate start, Coordinate goal,
+                    SearchContext* ctx);
+Path* hpa_path_to_nearest_survivor(const Grid* grid, Coordinate start,
+                                   uint64_t targets, SearchContext* ctx,
+                                   int* survivor_found);
+
+#endif // PATH_HIERARCHY_H
@@ -0,0 +1,312 @@
+#include "permutation_ga.h"
+#include "distance_tables.h"
+#include "fitness.h"
+#include "local_search.h"
+
+// ===== Evaluation =====
+
+// Longest prefix of the order that fits in a path, scored with the same
+// survivor, length and risk terms as calculate_fitness (a stitched path
+// has no collisions, so its risk is 0.1 per cell)
+float evaluate_permutation(Permutation* genome, int count, const Grid* grid,
+                           const Config* config) {
+    const DistanceTable* table = get_distance_table(grid);
+    int previous = table->start_source;
+    int cost = 0;
+    int visits = 0;
+
+    for (int i = 0; i < count; i++) {
+        int leg = source_distance(table, previous, genome->order[i]);
+        if (cost + leg + 1 > MAX_PATH_LENGTH) break;
+        cost += leg;
+        previous = genome->order[i];
+        visits++;
+    }
+
+    int length = cost + 1;
+    float max_expected_risk = MAX_PATH_LENGTH * 0.1f + 100.0f;
+    genome->visits = (uint8_t)visits;
+    genome->cost = (uint16_t)cost;
+    genome->fitness = config->w1_survivors * normalize_survivors(visits, grid->reachable_survivors) -
+                      config->w3_length * normalize_length(length, MAX_PATH_LENGTH) -
+                      config->w4_risk * normalize_risk(length * 0.1f, max_expected_risk);
+    return genome->fitness;
+}
+
+// ===== Crossover =====
+
+static void pick_segment(int count, Rng* rng, int* a, int* b) {
+    *a = (int)rng_range(rng, (uint32_t)count);
+    *b = (int)rng_range(rng, (uint32_t)count);
+    if (*a > *b) {
+        int swap = *a;
+        *a = *b;
+        *b = swap;
+    }
+}
+
+// OX: keep p1's segment in place, fill the remaining slots with the
+// missing survivors in p2's order, starting after the segment
+void order_crossover(const Permutation* p1, const Permutation* p2,
+                     Permutation* child, int count, Rng* rng) {
+    int a, b;
+    pick_segment(count, rng, &a, &b);
+
+    uint64_t used = 0;
+    for (int i = a; i <= b; i++) {
+        child->order[i] = p1->order[i];
+        used |= 1ULL << p1->order[i];
+    }
+
+    int slot = (b + 1) % count;
+    for (int k = 0; k < count; k++) {
+        int survivor = p2->order[(b + 1 + k) % count];
+        if (used & (1ULL << survivor)) continue;
+        child->order[slot] = (uint8_t)survivor;
+        slot = (slot + 1) % count;
+    }
+}
+
+// PMX: keep p1's segment; p2's survivors displaced by it are placed by
+// following the segment's mapping, everything else stays where p2 has it
+void pmx_crossover(const Permutation* p1, const Permutation* p2,
+                   Permutation* child, int count, Rng* rng) {
+    int a, b;
+    pick_segment(count, rng, &a, &b);
+
+    int position_in_p2[MAX_SURVIVORS];
+    for (int i = 0; i < count; i++) position_in_p2[p2->order[i]] = i;
+
+    int filled[MAX_SURVIVORS] = {0};
+    uint64_t used = 0;
+    for (int i = a; i <= b; i++) {
+        child->order[i] = p1->order[i];
+        filled[i] = 1;
+        used |= 1ULL << p1->order[i];
+    }
+
+    for (int i = a; i <= b; i++) {
+        int survivor = p2->order[i];
+        if (used & (1ULL << survivor)) continue;
+
+        int slot = i;
+        while (slot >= a && slot <= b) {
+            slot = position_in_p2[p1->order[slot]];
+        }
+        child->order[slot] = (uint8_t)survivor;
+        filled[slot] = 1;
+        used |= 1ULL << survivor;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!filled[i]) child->order[i] = p2->order[i];
+    }
+}
+
+// ===== Mutation =====
+
+void mutate_permutation(Permutation* genome, int count, float mutation_rate, Rng* rng) {
+    if (count < 2 || rng_float(rng) >= mutation_rate) return;
+
+    int a, b;
+    pick_segment(count, rng, &a, &b);
+
+    if (rng_range(rng, 2) == 0) {
+        uint8_t swap = genome->order[a];
+        genome->order[a] = genome->order[b];
+        genome->order[b] = swap;
+    } else {
+        for (; a < b; a++, b--) {
+            uint8_t swap = genome->order[a];
+            genome->order[a] = genome->order[b];
+            genome->order[b] = swap;
+        }
+    }
+}
+
+// ===== Decoding =====
+
+Path* decode_permutation(const Permutation* genome, const Grid* grid) {
+    int order[MAX_SURVIVORS];
+    for (int i = 0; i < genome->visits; i++) order[i] = genome->order[i];
+
+    Path* path = stitch_visit_order(grid, get_distance_table(grid), order,
+                                    genome->visits, NULL);
+    if (!path) path = create_path(1);
+    return path;
+}
+
+// ===== Evolution =====
+
+static int compare_permutations(const void* a, const void* b) {
+    float fa = ((const Permutation*)a)->fitness;
+    float fb = ((const Permutation*)b)->fitness;
+    return (fa < fb) - (fa > fb);
+}
+
+static const Permutation* permutation_tournament(const Permutation* population,
+                                                 int pop_size, int size, Rng* rng) {
+    const Permutation* best = &population[rng_range(rng, (uint32_t)pop_size)];
+    for (int i = 1; i < size; i++) {
+        const Permutation* other = &population[rng_range(rng, (uint32_t)pop_size)];
+        if (other->fitness > best->fitness) best = other;
+    }
+    return best;
+}
+
+// Slot 0 is the nearest-neighbour order, the rest are random shuffles
+static void seed_permutations(Permutation* population, int pop_size, const int* survivors,
+                              int count, const Grid* grid, Rng* rng) {
+    const DistanceTable* table = get_distance_table(grid);
+    uint64_t left = 0;
+    for (int i = 0; i < count; i++) left |= 1ULL << survivors[i];
+
+    int previous = table->start_source;
+    for (int i = 0; i < count; i++) {
+        int nearest = -1;
+        for (int k = 0; k < count; k++) {
+            int s = survivors[k];
+            if (!(left & (1ULL << s))) continue;
+            if (nearest < 0 || source_distance(table, previous, s) <
+                               source_distance(table, previous, nearest)) {
+                nearest = s;
+            }
+        }
+        population[0].order[i] = (uint8_t)nearest;
+        left &= ~(1ULL << nearest);
+        previous = nearest;
+    }
+
+    for (int p = 1; p < pop_size; p++) {
+        for (int i = 0; i < count; i++) population[p].order[i] = (uint8_t)survivors[i];
+        for (int i = count - 1; i > 0; i--) {
+            int j = (int)rng_range(rng, (uint32_t)(i + 1));
+            uint8_t swap = population[p].order[i];
+            population[p].order[i] = population[p].order[j];
+            population[p].order[j] = swap;
+        }
+    }
+}
+
+static void write_permutation_stats(FILE* stats_file, const Permutation* population,
+                                    int pop_size, int generation) {
+    double fitness_sum = 0.0;
+    double visits_sum = 0.0;
+    double length_sum = 0.0;
+    for (int i = 0; i < pop_size; i++) {
+        fitness_sum += population[i].fitness;
+        visits_sum += population[i].visits;
+        length_sum += population[i].cost + 1;
+    }
+    fprintf(stats_file, "%d,%.2f,%.2f,%.2f,%.2f,%.2f\n", generation,
+            population[0].fitness, fitness_sum / pop_size,
+            population[pop_size - 1].fitness, visits_sum / pop_size,
+            length_sum / pop_size);
+    fflush(stats_file);
+}
+
+Path** evolve_permutations(const Grid* grid, const Config* config, FILE* stats_file,
+                           int* decoded_count, int* generations) {
+    const DistanceTable* table = get_distance_table(grid);
+    int survivors[MAX_SURVIVORS];
+    int count = 0;
+    for (int s = 0; s < grid->num_survivors; s++) {
+        if (source_distance(table, table->start_source, s) >= 0) survivors[count++] = s;
+    }
+
+    int pop_size = config->population_size;
+    Permutation* current = (Permutation*)safe_calloc(pop_size, sizeof(Permutation));
+    Permutation* next = (Permutation*)safe_calloc(pop_size, sizeof(Permutation));
+
+    Rng rng;
+    rng_seed_stream(&rng, config->seed, rng_stream_id(RNG_DOMAIN_PERMUTATION, 0, 0));
+    seed_permutations(current, pop_size, survivors, count, grid, &rng);
+    for (int i = 0; i < pop_size; i++) {
+        evaluate_permutation(&current[i], count, grid, config);
+    }
+
+    int elitism_count = (pop_size * config->elitism_percent) / 100;
+    if (elitism_count < 1) elitism_count = 1;
+    if (elitism_count > pop_size / 2) elitism_count = pop_size / 2;
+
+    printf("Permutation genome: %d reachable survivors, %d bytes per individual\n",
+           count, (int)sizeof(Permutation));
+
+    int generation = 0;
+    int stagnation_counter = 0;
+    float prev_best_fitness = 0.0f;
+    double start_time = get_time_ms();
+
+    while (generation < config->max_generations) {
+        qsort(current, pop_size, sizeof(Permutation), compare_permutations);
+        float best_fitness = current[0].fitness;
+
+        if (config->verbose) {
+            printf("Generation %d: best %.2f (%d survivors, %d steps)\n",
+                   generation + 1, best_fitness, current[0].visits, current[0].cost + 1);
+        } else {
+            print_progress_bar(generation + 1, config->max_generations, "Evolution");
+        }
+        if (stats_file) {
+            write_permutation_stats(stats_file, current, pop_size, generation + 1);
+        }
+
+        if (fabs(best_fitness - prev_best_fitness) < 0.01) {
+            stagnation_counter++;
+        } else {
+            stagnation_counter = 0;
+        }
+        if (stagnation_counter >= config->stagnation_limit) {
+            printf("\n✓ Stopping: No improvement for %d generations\n",
+                   config->stagnation_limit);
+            break;
+        }
+
+        double elapsed = (get_time_ms() - start_time) / 1000.0;
+        if (config->time_limit > 0 && elapsed > config->time_limit) {
+            printf("\n✓ Stopping: Time limit of %d seconds reached (%.1fs)\n",
+                   config->time_limit, elapsed);
+            break;
+        }
+        prev_best_fitness = best_fitness;
+
+        memcpy(next, current, elitism_count * sizeof(Permutation));
+        for (int i = elitism_count; i < pop_size; i++) {
+            const Permutation* p1 = permutation_tournament(current, pop_size,
+                                                           config->tournament_size, &rng);
+            const Permutation* p2 = permutation_tournament(current, pop_size,
+                                                           config->tournament_size, &rng);
+
+            if (count > 1 && rng_float(&rng) < config->crossover_rate) {
+                if (rng_range(&rng, 2) == 0) order_crossover(p1, p2, &next[i], count, &rng);
+                else pmx_crossover(p1, p2, &next[i], count, &rng);
+            } else {
+                next[i] = *p1;
+            }
+            mutate_permutation(&next[i], count, config->mutation_rate, &rng);
+            evaluate_permutation(&next[i], count, grid, config);
+        }
+
+        Permutation* swap = current;
+        current = next;
+        next = swap;
+        generation++;
+    }
+
+    qsort(current, pop_size, sizeof(Permutation), compare_permutations);
+
+    // Only the best genomes are turned into paths and fully scored
+    int decoded = pop_size < DECODED_PERMUTATIONS ? pop_size : DECODED_PERMUTATIONS;
+    Path** population = (Path**)safe_malloc(decoded * sizeof(Path*));
+    for (int i = 0; i < decoded; i++) {
+        population[i] = decode_permutation(&current[i], grid);
+        update_path_fitness(population[i], grid, config);
+    }
+    qsort(population, decoded, sizeof(Path*), compare_paths_by_fitness);
+
+    free(current);
+    free(next);
+    *decoded_count = decoded;
+    *generations = generation;
+    return population;
+}
@@ -0,0 +1,48 @@
+#ifndef PERMUTATION_GA_H
+#define PERMUTATION_GA_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+#include "path_generator.h"
+
+// ===== Permutation-Encoded GA =====
+// Alternative genome: the order in which to visit the survivors reachable
+// from the start, one byte per survivor. The tour is the longest prefix of
+// that order whose shortest-path length fits in MAX_PATH_LENGTH, and it is
+// scored from the survivor distance tables alone, so an evaluation is a
+// handful of table lookups. There is no coverage term: the cells a tour
+// sweeps are unknown until it is decoded, and coverage only enters when the
+// decoded best paths are ranked. Collapse events are not supported.
+// Order crossover (OX) or partially mapped crossover (PMX), then swap or
+// inversion mutation.
+// Only the best genomes are decoded into concrete paths, at the end.
+
+typedef enum {
+    GENOME_PATH = 0,
+    GENOME_PERMUTATION = 1
+} GenomeEncoding;
+
+#define DECODED_PERMUTATIONS 50  // Best genomes turned into paths for output
+
+typedef struct {
+    uint8_t order[MAX_SURVIVORS];  // Survivor indices, all reachable ones
+    uint8_t visits;                // Tour prefix that fits in a path
+    uint16_t cost;                 // Steps of that prefix
+    float fitness;
+} Permutation;
+
+float evaluate_permutation(Permutation* genome, int count, const Grid* grid,
+                           const Config* config);
+void order_crossover(const Permutation* p1, const Permutation* p2,
+                     Permutation* child, int count, Rng* rng);
+void pmx_crossover(const Permutation* p1, const Permutation* p2,
+                   Permutation* child, int count, Rng* rng);
+void mutate_permutation(Permutation* genome, int count, float mutation_rate, Rng* rng);
+Path* decode_permutation(const Permutation* genome, const Grid* grid);
+
+// Run the whole evolution; returns the decoded best paths sorted by their
+// full fitness. Progress rows go to 'stats_file' like the path GA's.
+Path** evolve_permutations(const Grid* grid, const Config* config, FILE* stats_file,
+                           int* decoded_count, int* generations);
+
+#endif // PERMUTATION_GA_H
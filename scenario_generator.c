@@ -0,0 +1,246 @@
+#include "scenario_generator.h"
+
+// ===== Scenario Setup =====
+
+ScenarioType parse_scenario_type(const char* name) {
+    if (strcmp(name, "rubble") == 0) return SCENARIO_RUBBLE;
+    if (strcmp(name, "corridors") == 0) return SCENARIO_CORRIDORS;
+    if (strcmp(name, "floors") == 0) return SCENARIO_FLOORS;
+    if (strcmp(name, "random") != 0) {
+        warning("Unknown SCENARIO_TYPE, using random");
+    }
+    return SCENARIO_RANDOM;
+}
+
+const char* scenario_type_name(ScenarioType type) {
+    switch (type) {
+        case SCENARIO_RUBBLE:    return "rubble";
+        case SCENARIO_CORRIDORS: return "corridors";
+        case SCENARIO_FLOORS:    return "floors";
+        default:                 return "random";
+    }
+}
+
+ScenarioOptions scenario_options_from_config(const Config* config) {
+    ScenarioOptions options;
+    options.seed = config->scenario_seed;
+    if (options.seed == 0) {
+        // No fixed seed: derive one, it is reported so the run can be repeated
+        options.seed = ((uint64_t)time(NULL) << 20) ^ (uint64_t)getpid();
+    }
+    options.type = parse_scenario_type(config->scenario_type);
+    options.obstacle_percent = config->obstacle_percent;
+    options.num_survivors = config->num_survivors;
+    options.start = config->start_pos;
+    return options;
+}
+
+// ===== Helpers =====
+
+static void mark_obstacle(Grid* grid, int index) {
+    if (grid->cell_data[index] == CELL_EMPTY) {
+        grid->cell_data[index] = CELL_OBSTACLE;
+        grid->obstacle_count++;
+    }
+}
+
+static void clear_cell(Grid* grid, int index) {
+    if (grid->cell_data[index] == CELL_OBSTACLE) {
+        grid->cell_data[index] = CELL_EMPTY;
+        grid->obstacle_count--;
+    }
+}
+
+// Collect indices of all empty cells (the start cell is never empty)
+static int collect_empty_cells(const Grid* grid, int* out) {
+    int count = 0;
+    for (int i = 0; i < grid->total_cells; i++) {
+        if (grid->cell_data[i] == CELL_EMPTY) {
+            out[count++] = i;
+        }
+    }
+    return count;
+}
+
+// ===== Shuffle-Based Placement =====
+
+// Pick 'count' distinct empty cells with a partial Fisher-Yates shuffle
+int scatter_obstacles(Grid* grid, Rng* rng, int count) {
+    int* cells = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int available = collect_empty_cells(grid, cells);
+    if (count > available) count = available;
+
+    for (int i = 0; i < count; i++) {
+        int j = i + (int)rng_range(rng, (uint32_t)(available - i));
+        int picked = cells[j];
+        cells[j] = cells[i];
+        cells[i] = picked;
+        mark_obstacle(grid, picked);
+    }
+
+    free(cells);
+    return count;
+}
+
+int scatter_survivors(Grid* grid, Rng* rng, int count) {
+    if (count > MAX_SURVIVORS) count = MAX_SURVIVORS;
+
+    int* cells = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int available = collect_empty_cells(grid, cells);
+    if (count > available) {
+        warning("Could not place all survivors due to grid constraints");
+        count = available;
+    }
+
+    free(grid->survivors);
+    grid->survivors = (Coordinate*)safe_malloc(MAX_SURVIVORS * sizeof(Coordinate));
+    grid->num_survivors = 0;
+
+    for (int i = 0; i < count; i++) {
+        int j = i + (int)rng_range(rng, (uint32_t)(available - i));
+        int picked = cells[j];
+        cells[j] = cells[i];
+        cells[i] = picked;
+
+        grid->cell_data[picked] = CELL_SURVIVOR;
+        grid->survivors[grid->num_survivors++] = cell_coordinate(grid, picked);
+    }
+
+    free(cells);
+    return count;
+}
+
+// ===== Structured Debris =====
+
+// Random-walk rubble piles until 'target' obstacles exist. The walk budget
+// is proportional to the target; any shortfall is scattered uniformly.
+static void grow_rubble(Grid* grid, Rng* rng, int target) {
+    long long budget = 4LL * (target - grid->obstacle_count);
+
+    while (grid->obstacle_count < target && budget > 0) {
+        Coordinate c = cell_coordinate(grid, (int)rng_range(rng, (uint32_t)grid->total_cells));
+        int pile_size = 8 + (int)rng_range(rng, 57);
+
+        for (int step = 0; step < pile_size * 2 && grid->obstacle_count < target; step++) {
+            mark_obstacle(grid, cell_index(grid, c));
+            budget--;
+
+            // Piles spread mostly sideways, occasionally across floors
+            int d = (rng_range(rng, 8) == 0) ? DIR_POS_Z + (int)rng_range(rng, 2)
+                                             : (int)rng_range(rng, 4);
+            Coordinate next = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+            if (is_valid_coordinate(grid, next)) c = next;
+        }
+    }
+
+    if (grid->obstacle_count < target) {
+        scatter_obstacles(grid, rng, target - grid->obstacle_count);
+    }
+}
+
+// Rooms of size 'room' separated by walls, one doorway per wall segment
+// and a hallway through the middle of every floor
+static void carve_floor_plans(Grid* grid, Rng* rng) {
+    int min_side = grid->size_x < grid->size_y ? grid->size_x : grid->size_y;
+    int room = min_side / 5;
+    if (room < 4) room = 4;
+
+    for (int z = 0; z < grid->size_z; z++) {
+        // Walls
+        for (int x = 0; x < grid->size_x; x++) {
+            for (int y = 0; y < grid->size_y; y++) {
+                if (x % room == room - 1 || y % room == room - 1) {
+                    mark_obstacle(grid, cell_index(grid, create_coordinate(x, y, z)));
+                }
+            }
+        }
+
+        // Doorways: one gap in every wall segment between neighboring rooms
+        for (int rx = 0; rx * room < grid->size_x; rx++) {
+            for (int ry = 0; ry * room < grid->size_y; ry++) {
+                int wall_x = rx * room + room - 1;
+                int wall_y = ry * room + room - 1;
+                int span_x = grid->size_x - rx * room < room - 1 ? grid->size_x - rx * room : room - 1;
+                int span_y = grid->size_y - ry * room < room - 1 ? grid->size_y - ry * room : room - 1;
+
+                if (wall_x < grid->size_x && span_y > 0) {
+                    int y = ry * room + (int)rng_range(rng, (uint32_t)span_y);
+                    clear_cell(grid, cell_index(grid, create_coordinate(wall_x, y, z)));
+                }
+                if (wall_y < grid->size_y && span_x > 0) {
+                    int x = rx * room + (int)rng_range(rng, (uint32_t)span_x);
+                    clear_cell(grid, cell_index(grid, create_coordinate(x, wall_y, z)));
+                }
+            }
+        }
+
+        // Main hallway
+        int hall_y = grid->size_y / 2;
+        for (int x = 0; x < grid->size_x; x++) {
+            clear_cell(grid, cell_index(grid, create_coordinate(x, hall_y, z)));
+        }
+    }
+}
+
+// Upper floors partially pancaked: solid slabs with a few survivable voids
+static void collapse_floors(Grid* grid, Rng* rng) {
+    for (int z = 1; z < grid->size_z; z++) {
+        if (rng_range(rng, 2) == 0) continue;
+
+        int slabs = 1 + (int)rng_range(rng, 3);
+        for (int s = 0; s < slabs; s++) {
+            int w = grid->size_x / 4 + (int)rng_range(rng, (uint32_t)(grid->size_x / 4 + 1));
+            int h = grid->size_y / 4 + (int)rng_range(rng, (uint32_t)(grid->size_y / 4 + 1));
+            int x0 = (int)rng_range(rng, (uint32_t)(grid->size_x - w + 1));
+            int y0 = (int)rng_range(rng, (uint32_t)(grid->size_y - h + 1));
+
+            for (int x = x0; x < x0 + w; x++) {
+                for (int y = y0; y < y0 + h; y++) {
+                    if (rng_range(rng, 10) != 0) {
+                        mark_obstacle(grid, cell_index(grid, create_coordinate(x, y, z)));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ===== Scenario Generation =====
+
+void generate_scenario(Grid* grid, const ScenarioOptions* options) {
+    Rng rng;
+    rng_seed(&rng, options->seed);
+
+    for (int i = 0; i < grid->total_cells; i++) {
+        grid->cell_data[i] = CELL_EMPTY;
+    }
+    grid->obstacle_count = 0;
+    set_start_position(grid, options->start);
+
+    int percent = options->obstacle_percent;
+    if (percent < 0 || percent > 100) {
+        warning("Invalid obstacle percentage, using 25%");
+        percent = 25;
+    }
+    int target = (int)((long long)grid->total_cells * percent / 100);
+
+    switch (options->type) {
+        case SCENARIO_RUBBLE:
+            grow_rubble(grid, &rng, target);
+            break;
+        case SCENARIO_CORRIDORS:
+            carve_floor_plans(grid, &rng);
+            grow_rubble(grid, &rng, target);
+            break;
+        case SCENARIO_FLOORS:
+            collapse_floors(grid, &rng);
+            grow_rubble(grid, &rng, target);
+            break;
+        default:
+            scatter_obstacles(grid, &rng, target);
+            break;
+    }
+
+    scatter_survivors(grid, &rng, options->num_survivors);
+    build_grid_tables(grid);
+}
@@ -0,0 +1,34 @@
+#ifndef SCENARIO_GENERATOR_H
+#define SCENARIO_GENERATOR_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+
+// ===== Scenario Types =====
+typedef enum {
+    SCENARIO_RANDOM = 0,     // Uniformly scattered debris
+    SCENARIO_RUBBLE = 1,     // Clustered rubble piles
+    SCENARIO_CORRIDORS = 2,  // Room/corridor floor plans with doorways
+    SCENARIO_FLOORS = 3      // Collapsed floor slabs with voids
+} ScenarioType;
+
+// Everything needed to rebuild the same scenario bit for bit
+typedef struct {
+    uint64_t seed;
+    ScenarioType type;
+    int obstacle_percent;    // Target density (structured types may exceed it)
+    int num_survivors;
+    Coordinate start;
+} ScenarioOptions;
+
+// ===== Scenario Setup =====
+ScenarioType parse_scenario_type(const char* name);
+const char* scenario_type_name(ScenarioType type);
+ScenarioOptions scenario_options_from_config(const Config* config);
+
+// ===== Generation (all linear in the number of cells) =====
+void generate_scenario(Grid* grid, const ScenarioOptions* options);
+int scatter_obstacles(Grid* grid, Rng* rng, int count);
+int scatter_survivors(Grid* grid, Rng* rng, int count);
+
+#endif // SCENARIO_GENERATOR_H
@@ -0,0 +1,140 @@
+#include "search_queue.h"
+
+// ===== Indexed Binary Heap =====
+
+static int heap_less(const IndexedHeap* heap, int a, int b) {
+    if (heap->f[a] != heap->f[b]) return heap->f[a] < heap->f[b];
+    return heap->g[a] > heap->g[b];
+}
+
+static void heap_place(IndexedHeap* heap, int slot, int cell) {
+    heap->items[slot] = cell;
+    heap->position[cell] = slot;
+}
+
+static void heap_sift_up(IndexedHeap* heap, int slot) {
+    int cell = heap->items[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!heap_less(heap, cell, heap->items[parent])) break;
+        heap_place(heap, slot, heap->items[parent]);
+        slot = parent;
+    }
+    heap_place(heap, slot, cell);
+}
+
+static void heap_sift_down(IndexedHeap* heap, int slot) {
+    int cell = heap->items[slot];
+    for (;;) {
+        int child = 2 * slot + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && heap_less(heap, heap->items[child + 1], heap->items[child])) {
+            child++;
+        }
+        if (!heap_less(heap, heap->items[child], cell)) break;
+        heap_place(heap, slot, heap->items[child]);
+        slot = child;
+    }
+    heap_place(heap, slot, cell);
+}
+
+void heap_init(IndexedHeap* heap, int* items, int* position,
+               const float* f, const float* g) {
+    heap->items = items;
+    heap->position = position;
+    heap->size = 0;
+    heap->f = f;
+    heap->g = g;
+}
+
+void heap_push(IndexedHeap* heap, int cell) {
+    heap->items[heap->size] = cell;
+    heap->position[cell] = heap->size;
+    heap->size++;
+    heap_sift_up(heap, heap->size - 1);
+}
+
+// Call after lowering f[cell] of a queued cell
+void heap_decrease(IndexedHeap* heap, int cell) {
+    heap_sift_up(heap, heap->position[cell]);
+}
+
+int heap_pop(IndexedHeap* heap) {
+    if (heap->size == 0) return -1;
+
+    int top = heap->items[0];
+    heap->size--;
+    if (heap->size > 0) {
+        heap->items[0] = heap->items[heap->size];
+        heap_sift_down(heap, 0);
+    }
+    return top;
+}
+
+// ===== Dial Bucket Queue =====
+
+void bucket_init(BucketQueue* queue, int* next, int* prev, int* key) {
+    for (int i = 0; i < BUCKET_RING_SIZE; i++) {
+        queue->head[i] = -1;
+    }
+    queue->next = next;
+    queue->prev = prev;
+    queue->key = key;
+    queue->cursor = 0;
+    queue->size = 0;
+}
+
+void bucket_push(BucketQueue* queue, int cell, int key) {
+    int slot = key % BUCKET_RING_SIZE;
+
+    queue->key[cell] = key;
+    queue->prev[cell] = -1;
+    queue->next[cell] = queue->head[slot];
+    if (queue->head[slot] >= 0) {
+        queue->prev[queue->head[slot]] = cell;
+    }
+    queue->head[slot] = cell;
+
+    if (queue->size == 0 || key < queue->cursor) {
+        queue->cursor = key;
+    }
+    queue->size++;
+}
+
+static void bucket_unlink(BucketQueue* queue, int cell) {
+    int slot = queue->key[cell] % BUCKET_RING_SIZE;
+
+    if (queue->prev[cell] >= 0) {
+        queue->next[queue->prev[cell]] = queue->next[cell];
+    } else {
+        queue->head[slot] = queue->next[cell];
+    }
+    if (queue->next[cell] >= 0) {
+        queue->prev[queue->next[cell]] = queue->prev[cell];
+    }
+    queue->size--;
+}
+
+// Move a queued cell to a lower key
+void bucket_decrease(BucketQueue* queue, int cell, int key) {
+    bucket_unlink(queue, cell);
+    bucket_push(queue, cell, key);
+}
+
+// Smallest queued key; moves the cursor up to it
+int bucket_min_key(BucketQueue* queue) {
+    while (queue->head[queue->cursor % BUCKET_RING_SIZE] < 0) {
+        queue->cursor++;
+    }
+    return queue->cursor;
+}
+
+// Pop a cell with the minimum key (LIFO within a bucket)
+int bucket_pop(BucketQueue* queue) {
+    if (queue->size == 0) return -1;
+
+    bucket_min_key(queue);
+    int cell = queue->head[queue->cursor % BUCKET_RING_SIZE];
+    bucket_unlink(queue, cell);
+    return cell;
+}
@@ -0,0 +1,47 @@
+#ifndef SEARCH_QUEUE_H
+#define SEARCH_QUEUE_H
+
+// ===== Priority Queues for Grid Search =====
+// Both queues hold cell indices and keep their per-cell bookkeeping in
+// caller-provided arrays sized to the grid, so push/pop/decrease-key never
+// search and never allocate.
+
+// ===== Indexed Binary Heap =====
+// Min-heap on f[cell]; ties prefer the larger g[cell] (deeper node).
+typedef struct {
+    int* items;          // Heap-ordered cell indices
+    int* position;       // Per-cell slot in items (valid while queued)
+    int size;
+    const float* f;      // Per-cell priority
+    const float* g;      // Per-cell tie-breaker
+} IndexedHeap;
+
+void heap_init(IndexedHeap* heap, int* items, int* position,
+               const float* f, const float* g);
+void heap_push(IndexedHeap* heap, int cell);
+void heap_decrease(IndexedHeap* heap, int cell);
+int heap_pop(IndexedHeap* heap);
+
+// ===== Dial Bucket Queue =====
+// Integer priorities in a ring of buckets with intrusive per-cell links.
+// Valid when every queued key lies within BUCKET_RING_SIZE of the smallest
+// one, which holds for unit step costs with a consistent integer heuristic
+// (a relaxation raises f by 0 or 2).
+#define BUCKET_RING_SIZE 8
+
+typedef struct {
+    int head[BUCKET_RING_SIZE];
+    int* next;           // Per-cell forward link (-1 = end)
+    int* prev;           // Per-cell backward link (-1 = bucket head)
+    int* key;            // Per-cell integer priority
+    int cursor;          // No queued key is below this value
+    int size;
+} BucketQueue;
+
+void bucket_init(BucketQueue* queue, int* next, int* prev, int* key);
+void bucket_push(BucketQueue* queue, int cell, int key);
+void bucket_decrease(BucketQueue* queue, int cell, int key);
+int bucket_pop(BucketQueue* queue);
+int bucket_min_key(BucketQueue* queue);    // Queue must not be empty
+
+#endif // SEARCH_QUEUE_H
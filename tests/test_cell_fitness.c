@@ -0,0 +1,76 @@
+#undef NDEBUG
+#include <assert.h>
+#include "fitness.h"
+#include "path_encoding.h"
+
+// ===== Cell-Id Fitness =====
+// The master scores Paths (coordinates converted to ids) and the workers
+// score move strings decoded straight into ids. On random walks over a
+// scenario grid, off-grid steps included, both must give the same scores,
+// and those must agree with the coordinate helpers in path_generator.c.
+
+#define WALKS 300
+#define WALK_CELLS 600
+
+static Path* random_walk(const Grid* grid, Rng* rng) {
+    int length = 1 + (int)rng_range(rng, WALK_CELLS);
+    Path* path = create_path(length);
+    Coordinate c = grid->start;
+    for (int i = 0; i < length; i++) {
+        add_coordinate_to_path(path, c);
+        int d = (int)rng_range(rng, NUM_DIRECTIONS);
+        c = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+        // Mostly stay on the grid; a few walks wander off and come back
+        if (!is_valid_coordinate(grid, c) && rng_range(rng, 4) != 0) c = path->coordinates[i];
+    }
+    return path;
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 44);
+
+    Config* config = create_default_config();
+    config->grid_x = 25;
+    config->grid_y = 20;
+    config->grid_z = 4;
+    config->scenario_seed = 44;
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+
+    static unsigned char moves[MAX_ENCODED_PATH_BYTES];
+    static CellId cells[WALK_CELLS];
+    int reached = 0;
+
+    for (int w = 0; w < WALKS; w++) {
+        Path* path = random_walk(grid, &rng);
+        update_path_fitness(path, grid, config);
+        assert(path->survivors_reached == count_survivors_in_path(path, grid));
+        if (is_valid_path(path, grid)) {
+            assert(path->collision_count == check_path_collisions(path, grid));
+        }
+        reached += path->survivors_reached > 0;
+
+        // Worker side: encoded moves decoded into ids
+        int bytes = encode_path_moves(path->coordinates, path->length, moves, sizeof(moves));
+        assert(bytes >= 0);
+        CellPath decoded;
+        decoded.cells = cells;
+        decoded.capacity = WALK_CELLS;
+        decoded.length = decode_path_cells(grid, path->coordinates[0], moves, bytes,
+                                           path->length, cells);
+        assert(decoded.length == path->length);
+        update_cell_path_fitness(&decoded, grid, config);
+
+        assert(decoded.survivors_reached == path->survivors_reached);
+        assert(decoded.collision_count == path->collision_count);
+        assert(decoded.fitness == path->fitness);
+        free_path(path);
+    }
+    assert(reached > 0);
+
+    free_grid(grid);
+    free_config(config);
+    printf("✓ test_cell_fitness passed\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+#undef NDEBUG
+#include <assert.h>
+#include "connector_cache.h"
+
+// ===== Connector Cache Under Collapses =====
+// Collapse batches patch the cache instead of emptying it. Every connector
+// still served afterwards must be walkable and as short as a fresh BFS
+// says, and entries the batch did not touch must survive it.
+
+#define PAIRS 300
+#define ROUNDS 20
+
+static int bfs_steps(const Grid* grid, int from, int to, int* level, int* queue) {
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    for (int i = 0; i < grid->total_cells; i++) level[i] = -1;
+
+    int head = 0;
+    int tail = 0;
+    level[from] = 0;
+    queue[tail++] = from;
+    while (head < tail) {
+        int cell = queue[head++];
+        if (cell == to) return level[cell];
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(grid->neighbor_mask[cell] & (1 << d))) continue;
+            int next = cell + offsets[d];
+            if (level[next] >= 0) continue;
+            level[next] = level[cell] + 1;
+            queue[tail++] = next;
+        }
+    }
+    return -1;
+}
+
+static int pair_open(const Grid* grid, int from, int to) {
+    return grid->cell_data[from] != CELL_OBSTACLE && grid->cell_data[to] != CELL_OBSTACLE;
+}
+
+static int random_open_cell(const Grid* grid, Rng* rng) {
+    int cell;
+    do {
+        cell = (int)rng_range(rng, (uint32_t)grid->total_cells);
+    } while (grid->cell_data[cell] == CELL_OBSTACLE);
+    return cell;
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 38);
+
+    Config* config = create_default_config();
+    config->grid_x = 30;
+    config->grid_y = 30;
+    config->grid_z = 4;
+    config->scenario_seed = 38;
+    config->landmark_count = 0;
+    configure_pathfinding(config);
+
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+    assert(create_connector_cache(1024) == 0);
+
+    int* level = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int from[PAIRS], to[PAIRS];
+    for (int p = 0; p < PAIRS; p++) {
+        from[p] = random_open_cell(grid, &rng);
+        to[p] = random_open_cell(grid, &rng);
+    }
+
+    long long survived = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int p = 0; p < PAIRS; p++) {
+            if (!pair_open(grid, from[p], to[p])) continue;
+            Path* path = connect_coordinates(grid, cell_coordinate(grid, from[p]),
+                                             cell_coordinate(grid, to[p]), NULL);
+            free_path(path);
+        }
+
+        CellDelta deltas[16];
+        int count = 1 + (int)rng_range(&rng, 16);
+        for (int i = 0; i < count; i++) {
+            deltas[i].coord = cell_coordinate(grid, (int)rng_range(&rng, (uint32_t)grid->total_cells));
+            deltas[i].blocked = rng_range(&rng, 3) != 0;
+        }
+        apply_obstacle_deltas(grid, deltas, count);
+
+        ConnectorCacheStats before;
+        get_connector_cache_stats(&before);
+        survived += before.used;
+
+        // Whatever is still cached is served as is; check it like a fresh search
+        for (int p = 0; p < PAIRS; p++) {
+            if (!pair_open(grid, from[p], to[p])) continue;
+            Path* cached = connector_cache_lookup(grid, from[p], to[p]);
+            if (!cached) continue;
+
+            assert(cell_index(grid, cached->coordinates[0]) == from[p]);
+            assert(cell_index(grid, cached->coordinates[cached->length - 1]) == to[p]);
+            assert(check_path_collisions(cached, grid) == 0);
+            for (int i = 1; i < cached->length; i++) {
+                assert(are_coordinates_adjacent(cached->coordinates[i - 1], cached->coordinates[i]));
+            }
+            assert(cached->length - 1 == bfs_steps(grid, from[p], to[p], level, queue));
+            free_path(cached);
+        }
+    }
+
+    ConnectorCacheStats stats;
+    get_connector_cache_stats(&stats);
+    assert(stats.invalidations == 0);
+    assert(stats.stale_entries > 0);
+    assert(survived > 0);
+
+    free(level);
+    free(queue);
+    destroy_connector_cache();
+    free_grid(grid);
+    free_config(config);
+    printf("✓ test_connector_cache passed\n");
+    return 0;
+}
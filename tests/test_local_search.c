@@ -0,0 +1,174 @@
+#undef NDEBUG
+#include <assert.h>
+#include "local_search.h"
+#include "fitness.h"
+
+// ===== Memetic Local Search =====
+// On random visit orders, improve_visit_order() must return a permutation
+// that no single 2-opt reversal or single-visit move can shorten, and
+// report the steps it saved. Cheapest insertion must keep the tour within
+// its budget. Stitched paths must be walkable and as long as the tour says,
+// and memetic_improve_path() must only ever return a valid, better path.
+
+#define SCENARIOS 6
+#define ORDERS 200
+#define WALKS 60
+#define WALK_CELLS 400
+
+static int is_permutation_of(const int* order, const int* original, int count) {
+    int seen[MAX_SURVIVORS] = {0};
+    for (int i = 0; i < count; i++) seen[original[i]]++;
+    for (int i = 0; i < count; i++) {
+        if (--seen[order[i]] < 0) return 0;
+    }
+    return 1;
+}
+
+// Neither neighbourhood move, tried exhaustively, finds a shorter tour
+static void assert_local_optimum(const DistanceTable* table, const int* order, int count) {
+    int cost = visit_order_cost(table, order, count);
+    int trial[MAX_SURVIVORS];
+
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            memcpy(trial, order, count * sizeof(int));
+            for (int a = i, b = j; a < b; a++, b--) {
+                int swap = trial[a];
+                trial[a] = trial[b];
+                trial[b] = swap;
+            }
+            assert(visit_order_cost(table, trial, count) >= cost);
+        }
+    }
+
+    for (int from = 0; from < count; from++) {
+        for (int to = 0; to < count; to++) {
+            int n = 0;
+            for (int k = 0; k < count; k++) {
+                if (k != from) trial[n++] = order[k];
+            }
+            memmove(trial + to + 1, trial + to, (count - 1 - to) * sizeof(int));
+            trial[to] = order[from];
+            assert(visit_order_cost(table, trial, count) >= cost);
+        }
+    }
+}
+
+static void assert_walkable(const Grid* grid, const Path* path) {
+    assert(path->length > 0 && coordinates_equal(path->coordinates[0], grid->start));
+    for (int i = 1; i < path->length; i++) {
+        assert(are_coordinates_adjacent(path->coordinates[i - 1], path->coordinates[i]));
+    }
+}
+
+// Reachable survivors in random order
+static int random_order(const DistanceTable* table, Rng* rng, int* order) {
+    int count = 0;
+    for (int s = 0; s < table->start_source; s++) {
+        if (source_distance(table, table->start_source, s) >= 0) order[count++] = s;
+    }
+    for (int i = count - 1; i > 0; i--) {
+        int j = (int)rng_range(rng, (uint32_t)i + 1);
+        int swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+    return count;
+}
+
+static void test_visit_orders(const Grid* grid, Rng* rng) {
+    const DistanceTable* table = get_distance_table(grid);
+    int order[MAX_SURVIVORS];
+    int original[MAX_SURVIVORS];
+
+    for (int r = 0; r < ORDERS; r++) {
+        int count = random_order(table, rng, order);
+        memcpy(original, order, count * sizeof(int));
+        int before = visit_order_cost(table, order, count);
+
+        int saved = improve_visit_order(table, order, count);
+        assert(saved >= 0 && saved == before - visit_order_cost(table, order, count));
+        assert(is_permutation_of(order, original, count));
+        assert_local_optimum(table, order, count);
+
+        Path* stitched = stitch_visit_order(grid, table, order, count, NULL);
+        assert(stitched);
+        assert_walkable(grid, stitched);
+        assert(stitched->length - 1 == visit_order_cost(table, order, count));
+        assert(check_path_collisions(stitched, grid) == 0);
+        assert(count_survivors_in_path(stitched, grid) == count);
+        free_path(stitched);
+
+        // Drop a random tail, then let insertion put survivors back
+        int kept = (int)rng_range(rng, (uint32_t)count + 1);
+        int budget = visit_order_cost(table, order, kept) + (int)rng_range(rng, 60);
+        int filled = insert_missing_survivors(table, order, kept, budget);
+        assert(filled >= kept && filled <= count);
+        assert(visit_order_cost(table, order, filled) <= budget);
+        uint64_t present = 0;
+        for (int i = 0; i < filled; i++) {
+            assert(!(present & (1ULL << order[i])));
+            present |= 1ULL << order[i];
+        }
+        if (budget >= MAX_PATH_LENGTH) assert(filled == count);
+    }
+}
+
+// Returns how many walks were improved
+static int test_improve_paths(const Grid* grid, const Config* config, Rng* rng) {
+    int count = 0;
+    for (int w = 0; w < WALKS; w++) {
+        int length = 1 + (int)rng_range(rng, WALK_CELLS);
+        Path* path = create_path(length);
+        Coordinate c = grid->start;
+        for (int i = 0; i < length; i++) {
+            add_coordinate_to_path(path, c);
+            int d = (int)rng_range(rng, NUM_DIRECTIONS);
+            Coordinate next = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+            if (is_valid_coordinate(grid, next)) c = next;
+        }
+        update_path_fitness(path, grid, config);
+
+        Path* improved = memetic_improve_path(path, grid, config);
+        if (improved) {
+            assert(improved->fitness > path->fitness);
+            assert(improved->length <= MAX_PATH_LENGTH);
+            assert_walkable(grid, improved);
+
+            float reported = improved->fitness;
+            update_path_fitness(improved, grid, config);
+            assert(improved->fitness == reported);
+            free_path(improved);
+            count++;
+        }
+        free_path(path);
+    }
+    return count;
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 41);
+
+    Config* config = create_default_config();
+    config->grid_x = 25;
+    config->grid_y = 20;
+    config->grid_z = 3;
+    config->num_survivors = 10;
+    configure_pathfinding(config);
+
+    int improved = 0;
+    for (int s = 0; s < SCENARIOS; s++) {
+        config->scenario_seed = (unsigned long long)(41 + s);
+        Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+        initialize_grid(grid, config);
+        test_visit_orders(grid, &rng);
+        improved += test_improve_paths(grid, config, &rng);
+        free_grid(grid);
+    }
+    assert(improved > 0);
+
+    free_config(config);
+    printf("✓ test_local_search passed\n");
+    return 0;
+}
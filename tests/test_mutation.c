@@ -0,0 +1,111 @@
+#undef NDEBUG
+#include <assert.h>
+#include "genetic_operators.h"
+
+// ===== Mutation Kernels =====
+// Loop removal must match a plain O(n^2) version on random walks full of
+// nested and overlapping loops; the cell index must agree with a scan; and
+// insertion must grow a path up to MAX_PATH_LENGTH and no further.
+
+#define WALKS 400
+#define WALK_CELLS 900
+
+static Path* random_walk(const Grid* grid, Rng* rng, int length) {
+    Path* path = create_path(length);
+    Coordinate c = create_coordinate((int)rng_range(rng, grid->size_x),
+                                     (int)rng_range(rng, grid->size_y),
+                                     (int)rng_range(rng, grid->size_z));
+    for (int i = 0; i < length; i++) {
+        add_coordinate_to_path(path, c);
+        int d = (int)rng_range(rng, NUM_DIRECTIONS);
+        Coordinate next = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+        // Now and then step off the grid, which loop removal keeps as is
+        if (is_valid_coordinate(grid, next) || rng_range(rng, 50) == 0) c = next;
+        if (!is_valid_coordinate(grid, c) && rng_range(rng, 2) == 0) c = path->coordinates[0];
+    }
+    return path;
+}
+
+// Reference: scan the kept prefix for every step
+static int remove_loops_slowly(const Grid* grid, const Coordinate* cells, int length,
+                               Coordinate* kept) {
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        int found = -1;
+        if (is_valid_coordinate(grid, cells[i])) {
+            for (int j = 0; j < count; j++) {
+                if (coordinates_equal(kept[j], cells[i])) {
+                    found = j;
+                    break;
+                }
+            }
+        }
+        if (found >= 0) count = found + 1;
+        else kept[count++] = cells[i];
+    }
+    return count;
+}
+
+static void test_remove_loop(const Grid* grid, Rng* rng) {
+    static Coordinate expected[WALK_CELLS];
+
+    for (int w = 0; w < WALKS; w++) {
+        Path* path = random_walk(grid, rng, 3 + (int)rng_range(rng, WALK_CELLS - 3));
+        int count = remove_loops_slowly(grid, path->coordinates, path->length, expected);
+
+        // Shared bodies must be left untouched
+        Path* shared = share_path(path);
+        mutate_remove_loop(path, grid);
+
+        assert(path->length == count);
+        assert(memcmp(path->coordinates, expected, count * sizeof(Coordinate)) == 0);
+        assert(shared->length >= count);
+
+        free_path(shared);
+        free_path(path);
+    }
+}
+
+static void test_cell_index(const Grid* grid, Rng* rng) {
+    for (int w = 0; w < WALKS; w++) {
+        Path* path = random_walk(grid, rng, 1 + (int)rng_range(rng, WALK_CELLS));
+        index_path_cells(path, grid);
+
+        for (int probe = 0; probe < 200; probe++) {
+            Coordinate c = cell_coordinate(grid, (int)rng_range(rng, (uint32_t)grid->total_cells));
+            int last = -1;
+            for (int i = 0; i < path->length; i++) {
+                if (coordinates_equal(path->coordinates[i], c)) last = i;
+            }
+            assert(indexed_path_position(grid, c) == last);
+            assert(indexed_path_contains(grid, c) == (last >= 0));
+        }
+        assert(!indexed_path_contains(grid, create_coordinate(-1, 0, 0)));
+        free_path(path);
+    }
+}
+
+static void test_insert_limit(const Grid* grid, Rng* rng) {
+    seed_random(46, 0);
+    Path* path = random_walk(grid, rng, 2);
+    for (int i = 0; i < MAX_PATH_LENGTH * 4; i++) {
+        mutate_insert_random(path, grid);
+        assert(path->length <= MAX_PATH_LENGTH);
+    }
+    assert(path->length == MAX_PATH_LENGTH);
+    free_path(path);
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 46);
+
+    Grid* grid = create_grid(12, 10, 3);
+    test_remove_loop(grid, &rng);
+    test_cell_index(grid, &rng);
+    test_insert_limit(grid, &rng);
+    free_grid(grid);
+
+    printf("✓ test_mutation passed\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+#undef NDEBUG
+#include <assert.h>
+#include "genetic_operators.h"
+#include "operator_selection.h"
+#include "fitness.h"
+
+// ===== Generation Arenas =====
+// Arena paths must grow in place of a heap realloc, keep their cells until
+// their own arena is reset, and hold body references until then. Run like
+// main.c's loop, the two arenas must stop spilling into overflow blocks
+// after a few generations, and dropping the old population must not touch
+// the new one (whose elites share the old elites' cells).
+
+#define GENERATIONS 30
+#define POPULATION 60
+
+static unsigned long long path_checksum(const Path* path) {
+    unsigned long long sum = (unsigned long long)path->length;
+    for (int i = 0; i < path->length; i++) {
+        Coordinate c = path->coordinates[i];
+        sum = sum * 1000003ULL + (unsigned long long)(c.x * 65536 + c.y * 256 + c.z);
+    }
+    return sum;
+}
+
+static void test_arena_paths(void) {
+    PathArena* arena = create_path_arena(4096);
+    Path* heap = create_path(4);
+    for (int i = 0; i < 50; i++) add_coordinate_to_path(heap, create_coordinate(i, 0, 0));
+
+    PathArena* previous = set_active_path_arena(arena);
+    assert(previous == NULL && active_path_arena() == arena);
+
+    // Growth takes new buffers from the arena, then overflow blocks
+    Path* paths[20];
+    for (int p = 0; p < 20; p++) {
+        paths[p] = create_path(2);
+        assert(paths[p]->arena == arena);
+        for (int i = 0; i < 40 + p; i++) {
+            add_coordinate_to_path(paths[p], create_coordinate(p, i, 0));
+        }
+    }
+    assert(arena->overflow_count > 0);
+    for (int p = 0; p < 20; p++) {
+        assert(paths[p]->length == 40 + p);
+        for (int i = 0; i < paths[p]->length; i++) {
+            assert(coordinates_equal(paths[p]->coordinates[i], create_coordinate(p, i, 0)));
+        }
+        free_path(paths[p]);    // No-op: the arena owns it
+    }
+
+    // Arena copies of a heap path hold a body reference until the reset
+    Path* copy = share_path(heap);
+    assert(copy->arena == arena && copy->body == heap->body);
+    assert(heap->body->refcount == 2);
+    Path* clone = clone_path(heap);
+    assert(clone->arena == arena && clone->body == NULL);
+    set_active_path_arena(NULL);
+
+    size_t in_use = arena->used + arena->overflow_bytes;
+    reset_path_arena(arena);
+    assert(heap->body->refcount == 1);
+    assert(arena->used == 0 && arena->overflow_count == 0 && arena->body_count == 0);
+    assert(arena->capacity >= in_use && arena->peak == in_use && arena->resets == 1);
+
+    // The same work now fits in the enlarged block
+    set_active_path_arena(arena);
+    for (int p = 0; p < 20; p++) {
+        Path* path = create_path(2);
+        for (int i = 0; i < 40 + p; i++) add_coordinate_to_path(path, create_coordinate(p, i, 0));
+    }
+    assert(arena->overflow_count == 0);
+    set_active_path_arena(NULL);
+
+    for (int i = 0; i < heap->length; i++) {
+        assert(coordinates_equal(heap->coordinates[i], create_coordinate(i, 0, 0)));
+    }
+    free_path(heap);
+    free_path_arena(arena);
+}
+
+static void test_generations(void) {
+    Config* config = create_default_config();
+    config->grid_x = 20;
+    config->grid_y = 20;
+    config->grid_z = 3;
+    config->scenario_seed = 45;
+    config->population_size = POPULATION;
+    configure_pathfinding(config);
+    configure_operator_selection(config);
+    seed_random(45, 0);
+
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+
+    Path** population = (Path**)safe_malloc(POPULATION * sizeof(Path*));
+    for (int i = 0; i < POPULATION; i++) {
+        population[i] = generate_random_path(grid, 60);
+        update_path_fitness(population[i], grid, config);
+    }
+    int ranked = elite_count(POPULATION, config);
+    if (ranked < 1) ranked = 1;
+    select_best_paths(population, POPULATION, ranked);
+
+    size_t bytes = (size_t)POPULATION * (sizeof(Path) + 64 * sizeof(Coordinate));
+    PathArena* arenas[2] = {create_path_arena(bytes), create_path_arena(bytes)};
+    int population_arena = -1;
+    int late_overflows = 0;
+    static unsigned long long sums[POPULATION];
+
+    for (int generation = 0; generation < GENERATIONS; generation++) {
+        for (int i = 0; i < POPULATION; i++) sums[i] = path_checksum(population[i]);
+
+        int next_arena = population_arena == 0 ? 1 : 0;
+        Path** next = create_next_generation(population, POPULATION, grid, config,
+                                             generation, arenas[next_arena]);
+        for (int i = 0; i < POPULATION; i++) {
+            assert(next[i]->arena == arenas[next_arena]);
+            update_path_fitness(next[i], grid, config);
+        }
+        select_best_paths(next, POPULATION, ranked);
+        if (generation >= GENERATIONS / 2) late_overflows += arenas[next_arena]->overflow_count;
+
+        // Breeding left the parents alone
+        for (int i = 0; i < POPULATION; i++) assert(path_checksum(population[i]) == sums[i]);
+
+        for (int i = 0; i < POPULATION; i++) sums[i] = path_checksum(next[i]);
+        if (population_arena >= 0) {
+            reset_path_arena(arenas[population_arena]);
+        } else {
+            for (int i = 0; i < POPULATION; i++) free_path(population[i]);
+            free(population);
+        }
+        for (int i = 0; i < POPULATION; i++) assert(path_checksum(next[i]) == sums[i]);
+
+        population = next;
+        population_arena = next_arena;
+    }
+    assert(late_overflows == 0);
+    assert(arenas[0]->resets + arenas[1]->resets == GENERATIONS - 1);
+
+    free_path_arena(arenas[0]);
+    free_path_arena(arenas[1]);
+    free_grid(grid);
+    free_config(config);
+}
+
+int main(void) {
+    test_arena_paths();
+    test_generations();
+    printf("✓ test_path_arena passed\n");
+    return 0;
+}
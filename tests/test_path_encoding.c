@@ -0,0 +1,221 @@
+#undef NDEBUG
+#include <assert.h>
+#include "path_encoding.h"
+#include "multiprocess.h"
+
+// ===== Move Encoding Round Trips =====
+// Random walks mixing unit moves, stays and long jumps (escapes) must
+// decode to the exact cells that were encoded: as coordinates, as cell ids
+// on a grid, through a best_path.moves file and through shared-memory
+// slots, spilled or not.
+
+#define WALKS 500
+#define WALK_CELLS 400
+
+static Coordinate random_step(Rng* rng, Coordinate from) {
+    uint32_t kind = rng_range(rng, 10);
+    if (kind < 7) {
+        int d = (int)rng_range(rng, NUM_DIRECTIONS);
+        return create_coordinate(from.x + DIR_DX[d], from.y + DIR_DY[d], from.z + DIR_DZ[d]);
+    }
+    if (kind < 8) return from;
+
+    // Escapes anywhere in the int16 range, edges included
+    return create_coordinate((int)rng_range(rng, 65536) - 32768,
+                             (int)rng_range(rng, 65536) - 32768,
+                             kind == 9 ? MAX_ENCODED_COORDINATE : (int)rng_range(rng, 64));
+}
+
+static void test_round_trip(Rng* rng) {
+    static Coordinate walk[WALK_CELLS];
+    static Coordinate decoded[WALK_CELLS];
+    static unsigned char moves[MAX_ENCODED_PATH_BYTES];
+
+    for (int w = 0; w < WALKS; w++) {
+        int length = 1 + (int)rng_range(rng, WALK_CELLS);
+        walk[0] = create_coordinate((int)rng_range(rng, 100), (int)rng_range(rng, 100),
+                                    (int)rng_range(rng, 10));
+        for (int i = 1; i < length; i++) {
+            walk[i] = random_step(rng, walk[i - 1]);
+        }
+
+        int bytes = encode_path_moves(walk, length, moves, sizeof(moves));
+        assert(bytes >= 0);
+        assert(decode_path_moves(walk[0], moves, bytes, length, decoded) == length);
+        for (int i = 0; i < length; i++) {
+            assert(coordinates_equal(walk[i], decoded[i]));
+        }
+
+        // Too little room fails instead of truncating
+        if (bytes > 0) {
+            assert(encode_path_moves(walk, length, moves, bytes - 1) == -1);
+        }
+
+        // The longest prefix that fits encodes into exactly that room
+        int capacity = (int)rng_range(rng, (uint32_t)bytes + 2);
+        int prefix = encoded_prefix_length(walk, length, capacity);
+        assert(prefix >= 1 && prefix <= length);
+        assert(encode_path_moves(walk, prefix, moves, capacity) >= 0);
+        if (prefix < length) {
+            assert(encode_path_moves(walk, prefix + 1, moves, capacity) == -1);
+        }
+    }
+}
+
+static void test_cell_ids(Rng* rng) {
+    Grid* grid = create_grid(20, 15, 6);
+    static Coordinate walk[WALK_CELLS];
+    static CellId cells[WALK_CELLS];
+    static unsigned char moves[MAX_ENCODED_PATH_BYTES];
+
+    for (int w = 0; w < WALKS; w++) {
+        int length = 1 + (int)rng_range(rng, WALK_CELLS);
+        walk[0] = create_coordinate(10, 7, 3);
+        for (int i = 1; i < length; i++) {
+            // Mostly unit moves, so walks wander off the grid and back
+            walk[i] = rng_range(rng, 20) == 0
+                ? create_coordinate((int)rng_range(rng, 20), (int)rng_range(rng, 15),
+                                    (int)rng_range(rng, 6))
+                : random_step(rng, walk[i - 1]);
+            if (abs(walk[i].x) > 40 || abs(walk[i].y) > 40 || abs(walk[i].z) > 40) {
+                walk[i] = walk[0];
+            }
+        }
+
+        int bytes = encode_path_moves(walk, length, moves, sizeof(moves));
+        assert(bytes >= 0);
+        assert(decode_path_cells(grid, walk[0], moves, bytes, length, cells) == length);
+        for (int i = 0; i < length; i++) {
+            assert(cells[i] == cell_id(grid, walk[i]));
+        }
+    }
+    free_grid(grid);
+}
+
+static void test_int16_limit(void) {
+    unsigned char moves[64];
+    Coordinate walk[2] = {create_coordinate(0, 0, 0),
+                          create_coordinate(MAX_ENCODED_COORDINATE + 1, 0, 0)};
+    assert(encode_path_moves(walk, 2, moves, sizeof(moves)) == -1);
+
+    walk[1] = create_coordinate(0, INT16_MIN - 1, 0);
+    assert(encode_path_moves(walk, 2, moves, sizeof(moves)) == -1);
+}
+
+static Path* walk_path(Rng* rng, int length, int jump_odds) {
+    Path* path = create_path(length);
+    Coordinate c = create_coordinate(5, 5, 1);
+    for (int i = 0; i < length; i++) {
+        add_coordinate_to_path(path, c);
+        int d = (int)rng_range(rng, NUM_DIRECTIONS);
+        c = rng_range(rng, (uint32_t)jump_odds) == 0
+            ? create_coordinate((int)rng_range(rng, 40), (int)rng_range(rng, 40),
+                                (int)rng_range(rng, 8))
+            : create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+    }
+    return path;
+}
+
+static void assert_same_cells(const Path* a, const Path* b, int length) {
+    assert(a->length >= length && b->length >= length);
+    for (int i = 0; i < length; i++) {
+        assert(coordinates_equal(a->coordinates[i], b->coordinates[i]));
+    }
+}
+
+static void test_files(Rng* rng) {
+    const char* file = "tests/bin/test_path_encoding.moves";
+
+    for (int w = 0; w < 50; w++) {
+        Path* path = walk_path(rng, (int)rng_range(rng, WALK_CELLS), 8);
+        assert(save_encoded_path(path, file));
+        Path* loaded = load_encoded_path(file);
+        assert(loaded && loaded->length == path->length);
+        assert_same_cells(path, loaded, path->length);
+        free_path(loaded);
+        free_path(path);
+    }
+
+    // Cut the moves short, then the header: both are rejected
+    Path* path = walk_path(rng, 200, 8);
+    assert(save_encoded_path(path, file));
+    FILE* f = fopen(file, "rb");
+    static unsigned char data[MAX_ENCODED_PATH_BYTES + 64];
+    size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+    size_t cuts[] = {size - 1, 12, 3};
+    for (int i = 0; i < 3; i++) {
+        f = fopen(file, "wb");
+        fwrite(data, 1, cuts[i], f);
+        fclose(f);
+        assert(load_encoded_path(file) == NULL);
+    }
+
+    // Wrong magic, and a byte count no path of that length could need
+    data[0] = 'X';
+    f = fopen(file, "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+    assert(load_encoded_path(file) == NULL);
+    data[0] = 'R';
+    int32_t counts[2] = {2, 1000};
+    memcpy(data + 10, counts, sizeof(counts));
+    f = fopen(file, "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+    assert(load_encoded_path(file) == NULL);
+
+    remove(file);
+    free_path(path);
+}
+
+static void test_shared_slots(Rng* rng) {
+    SharedData* shared = (SharedData*)safe_calloc(1, sizeof(SharedData));
+    Path* decoded = create_path(MAX_PATH_LENGTH);
+
+    // Escape-heavy paths spill whole; the rest stay in their slots
+    shared->escape_used = 0;
+    int spilled = 0;
+    for (int i = 0; i < 40; i++) {
+        Path* path = walk_path(rng, 1 + (int)rng_range(rng, MAX_PATH_LENGTH), i % 2 ? 4 : 200);
+        SharedPath* slot = &shared->paths[i];
+        assert(path_to_shared(path, slot, shared) == path->length);
+        spilled += slot->spill_offset != 0;
+
+        shared_to_path(slot, decoded);
+        assert(decoded->length == path->length);
+        assert_same_cells(path, decoded, path->length);
+        free_path(path);
+    }
+    assert(spilled > 0 && spilled < 40);
+
+    // Without an escape area (workers), or once it is full, a path keeps
+    // the prefix that fits in its slot
+    Path* path = walk_path(rng, MAX_PATH_LENGTH, 2);
+    int expected = encoded_prefix_length(path->coordinates, path->length, SHARED_MOVE_BYTES);
+    assert(expected < path->length);
+    assert(path_to_shared(path, &shared->paths[0], NULL) == expected);
+    shared->escape_used = ESCAPE_AREA_BYTES;
+    assert(path_to_shared(path, &shared->paths[1], shared) == expected);
+    shared_to_path(&shared->paths[1], decoded);
+    assert(decoded->length == expected);
+    assert_same_cells(path, decoded, expected);
+
+    free_path(path);
+    free_path(decoded);
+    free(shared);
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 43);
+
+    test_round_trip(&rng);
+    test_cell_ids(&rng);
+    test_int16_limit();
+    test_files(&rng);
+    test_shared_slots(&rng);
+
+    printf("✓ test_path_encoding passed\n");
+    return 0;
+}
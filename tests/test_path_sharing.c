@@ -0,0 +1,152 @@
+#undef NDEBUG
+#include <assert.h>
+#include "genetic_operators.h"
+#include "operator_selection.h"
+#include "fitness.h"
+
+// ===== Copy-On-Write Paths and Top-k Ranking =====
+// A shared path must read its source's cells until either side writes,
+// then the writer alone changes; a sole owner writes in place. Elites enter
+// the next generation as shared copies. select_best_paths() must leave the
+// same fitness values at the front, in order, as a full sort.
+
+#define RANKINGS 500
+#define MAX_POPULATION_SIZE 300
+
+static Path* line_path(int length) {
+    Path* path = create_path(length);
+    for (int i = 0; i < length; i++) add_coordinate_to_path(path, create_coordinate(i, 1, 2));
+    return path;
+}
+
+static int is_line(const Path* path, int length) {
+    if (path->length != length) return 0;
+    for (int i = 0; i < length; i++) {
+        if (!coordinates_equal(path->coordinates[i], create_coordinate(i, 1, 2))) return 0;
+    }
+    return 1;
+}
+
+static void test_copy_on_write(void) {
+    Path* source = line_path(30);
+    source->fitness = 7.5f;
+    Path* copy = share_path(source);
+    Path* second = share_path(source);
+    assert(copy->body == source->body && second->body == source->body);
+    assert(source->body->refcount == 3);
+    assert(copy->coordinates == source->coordinates);
+    assert(copy->fitness == source->fitness && is_line(copy, 30));
+
+    // Writing a copy detaches it; the others keep the shared cells
+    make_path_writable(copy);
+    assert(copy->body == NULL && copy->coordinates != source->coordinates);
+    copy->coordinates[0] = create_coordinate(9, 9, 9);
+    assert(source->body->refcount == 2);
+    assert(is_line(source, 30) && is_line(second, 30));
+
+    // Growing a shared path detaches it too
+    add_coordinate_to_path(second, create_coordinate(30, 1, 2));
+    assert(second->body == NULL && is_line(second, 31));
+    assert(is_line(source, 30) && source->body->refcount == 1);
+
+    // The last holder writes in place
+    Coordinate* cells = source->coordinates;
+    make_path_writable(source);
+    assert(source->coordinates == cells && source->body != NULL);
+    source->coordinates[29] = create_coordinate(0, 0, 0);
+
+    // Freed in any order, the body goes with its last reference
+    Path* late = share_path(source);
+    free_path(source);
+    assert(late->body->refcount == 1 && late->coordinates[29].x == 0);
+    free_path(late);
+    free_path(second);
+    free_path(copy);
+}
+
+static void test_shared_elites(void) {
+    Config* config = create_default_config();
+    config->grid_x = 15;
+    config->grid_y = 15;
+    config->grid_z = 2;
+    config->scenario_seed = 49;
+    config->population_size = 40;
+    configure_pathfinding(config);
+    configure_operator_selection(config);
+    seed_random(49, 0);
+
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+
+    Path* population[40];
+    for (int i = 0; i < 40; i++) {
+        population[i] = generate_random_path(grid, 40);
+        update_path_fitness(population[i], grid, config);
+    }
+    int elites = elite_count(40, config);
+    assert(elites > 0);
+    select_best_paths(population, 40, elites);
+
+    Path** next = create_next_generation(population, 40, grid, config, 0, NULL);
+    for (int i = 0; i < elites; i++) {
+        assert(next[i]->body != NULL && next[i]->body == population[i]->body);
+        assert(next[i]->fitness == population[i]->fitness);
+    }
+
+    for (int i = 0; i < 40; i++) {
+        free_path(population[i]);
+    }
+    for (int i = 0; i < 40; i++) {
+        free_path(next[i]);
+    }
+    free(next);
+    free_grid(grid);
+    free_config(config);
+}
+
+static int compare_floats_descending(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa < fb) - (fa > fb);
+}
+
+static void test_select_best(Rng* rng) {
+    static Path paths[MAX_POPULATION_SIZE];
+    static Path* population[MAX_POPULATION_SIZE];
+    static float sorted[MAX_POPULATION_SIZE];
+
+    for (int r = 0; r < RANKINGS; r++) {
+        int pop_size = 1 + (int)rng_range(rng, MAX_POPULATION_SIZE);
+        int k = 1 + (int)rng_range(rng, (uint32_t)pop_size + 2);
+        // Few distinct values on some rounds, so ties are common
+        int distinct = r % 3 == 0 ? 4 : 100000;
+        for (int i = 0; i < pop_size; i++) {
+            paths[i].fitness = (float)rng_range(rng, (uint32_t)distinct);
+            population[i] = &paths[i];
+            sorted[i] = paths[i].fitness;
+        }
+        qsort(sorted, pop_size, sizeof(float), compare_floats_descending);
+
+        select_best_paths(population, pop_size, k);
+
+        int front = k < pop_size ? k : pop_size;
+        for (int i = 0; i < front; i++) {
+            assert(population[i]->fitness == sorted[i]);
+        }
+        // Still a permutation of the population
+        for (int i = 0; i < pop_size; i++) paths[i].length = 0;
+        for (int i = 0; i < pop_size; i++) population[i]->length++;
+        for (int i = 0; i < pop_size; i++) assert(paths[i].length == 1);
+    }
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 49);
+
+    test_copy_on_write();
+    test_shared_elites();
+    test_select_best(&rng);
+    printf("✓ test_path_sharing passed\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+#undef NDEBUG
+#include <assert.h>
+#include "jump_point_search.h"
+#include "path_hierarchy.h"
+
+// ===== Searches vs BFS =====
+// On every scenario type, A* (both open lists, with and without ALT), JPS
+// and bidirectional A* (with and without ALT) must find paths exactly as
+// long as a plain BFS says; HPA* must find a walkable path whenever BFS
+// does, never shorter. Some starts are obstacles, as in damaged genomes.
+
+#define QUERIES 150
+
+typedef Path* (*SearchFunction)(const Grid* grid, Coordinate start, Coordinate goal,
+                                SearchContext* ctx);
+
+typedef struct {
+    const char* name;
+    int astar_queue;
+    int landmarks;
+    int exact;                   // 0 = only bounded below by BFS
+    SearchFunction search;
+} SearchVariant;
+
+static const SearchVariant variants[] = {
+    {"A* (heap)",     0, 0, 1, find_path_astar},
+    {"A* (bucket)",   1, 0, 1, find_path_astar},
+    {"A* ALT (heap)", 0, 1, 1, find_path_astar},
+    {"A* ALT (bkt)",  1, 1, 1, find_path_astar},
+    {"JPS",           0, 0, 1, find_path_jps},
+    {"Bidirectional", 0, 0, 1, find_path_bidirectional},
+    {"Bidir ALT",     0, 1, 1, find_path_bidirectional},
+    {"HPA*",          0, 0, 0, find_path_hpa},
+};
+#define NUM_VARIANTS ((int)(sizeof(variants) / sizeof(variants[0])))
+
+static const char* scenarios[] = {"random", "rubble", "corridors", "floors"};
+#define NUM_SCENARIOS ((int)(sizeof(scenarios) / sizeof(scenarios[0])))
+
+// Steps from 'from' to every cell, -1 where unreachable
+static void bfs_distances(const Grid* grid, Coordinate from, int* distance, int* queue) {
+    for (int i = 0; i < grid->total_cells; i++) distance[i] = -1;
+
+    int head = 0;
+    int tail = 0;
+    distance[cell_index(grid, from)] = 0;
+    queue[tail++] = cell_index(grid, from);
+
+    while (head < tail) {
+        int cell = queue[head++];
+        Coordinate c = cell_coordinate(grid, cell);
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            Coordinate n = create_coordinate(c.x + DIR_DX[d], c.y + DIR_DY[d], c.z + DIR_DZ[d]);
+            if (!is_valid_coordinate(grid, n) || is_obstacle(grid, n)) continue;
+            int next = cell_index(grid, n);
+            if (distance[next] >= 0) continue;
+            distance[next] = distance[cell] + 1;
+            queue[tail++] = next;
+        }
+    }
+}
+
+static void assert_walk(const Path* path, const Grid* grid, Coordinate start, Coordinate goal) {
+    assert(is_valid_path(path, grid));
+    assert(check_path_collisions(path, grid) == is_obstacle(grid, start));
+    assert(coordinates_equal(path->coordinates[0], start));
+    assert(coordinates_equal(path->coordinates[path->length - 1], goal));
+    for (int i = 1; i < path->length; i++) {
+        assert(are_coordinates_adjacent(path->coordinates[i - 1], path->coordinates[i]));
+    }
+}
+
+static Coordinate random_open_cell(const Grid* grid, Rng* rng) {
+    Coordinate c;
+    do {
+        c = cell_coordinate(grid, (int)rng_range(rng, (uint32_t)grid->total_cells));
+    } while (is_obstacle(grid, c));
+    return c;
+}
+
+static void test_scenario(const char* scenario, Rng* rng) {
+    Config* config = create_default_config();
+    config->grid_x = 40;
+    config->grid_y = 40;
+    config->grid_z = 6;
+    config->hpa_cluster_size = 8;    // Several clusters per floor
+    config->seed = 34;
+    config->scenario_seed = 34;
+    snprintf(config->scenario_type, sizeof(config->scenario_type), "%s", scenario);
+
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+    SearchContext* ctx = create_search_context(grid);
+    int* distance = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int landmark_count = config->landmark_count;
+
+    int reachable = 0;
+    for (int q = 0; q < QUERIES; q++) {
+        // Some queries cross walls between components on purpose
+        Coordinate start = q % 5 == 0
+            ? cell_coordinate(grid, (int)rng_range(rng, (uint32_t)grid->total_cells))
+            : random_open_cell(grid, rng);
+        Coordinate goal = random_open_cell(grid, rng);
+        bfs_distances(grid, start, distance, queue);
+        int expected = distance[cell_index(grid, goal)];
+        if (expected >= 0) reachable++;
+
+        for (int v = 0; v < NUM_VARIANTS; v++) {
+            config->astar_queue = variants[v].astar_queue;
+            config->landmark_count = variants[v].landmarks ? landmark_count : 0;
+            configure_pathfinding(config);
+
+            Path* path = variants[v].search(grid, start, goal, ctx);
+            if (expected < 0) {
+                assert(path == NULL);
+                continue;
+            }
+
+            assert(path != NULL);
+            assert_walk(path, grid, start, goal);
+            if (variants[v].exact) {
+                assert(path->length - 1 == expected);
+            } else {
+                assert(path->length - 1 >= expected);
+            }
+            free_path(path);
+        }
+    }
+    assert(reachable > 0);
+
+    free(distance);
+    free(queue);
+    free_search_context(ctx);
+    free_grid(grid);
+    free_config(config);
+}
+
+// Calibration counts expansions, so it must settle on the same threshold
+// every time for the same grid
+static void test_calibration(const char* scenario) {
+    Config* config = create_default_config();
+    config->grid_x = 40;
+    config->grid_y = 40;
+    config->grid_z = 6;
+    config->scenario_seed = 35;
+    snprintf(config->scenario_type, sizeof(config->scenario_type), "%s", scenario);
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+
+    for (int landmarks = 0; landmarks <= 8; landmarks += 8) {
+        config->landmark_count = landmarks;
+        config->bidirectional_threshold = 0;
+        configure_pathfinding(config);
+        int threshold = calibrate_bidirectional_threshold(grid);
+        assert(threshold == -1 || threshold > 0);
+
+        configure_pathfinding(config);
+        assert(calibrate_bidirectional_threshold(grid) == threshold);
+    }
+
+    free_grid(grid);
+    free_config(config);
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 34);
+
+    for (int s = 0; s < NUM_SCENARIOS; s++) {
+        test_scenario(scenarios[s], &rng);
+        test_calibration(scenarios[s]);
+    }
+
+    printf("✓ test_pathfinding passed\n");
+    return 0;
+}
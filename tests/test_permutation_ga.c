@@ -0,0 +1,139 @@
+#undef NDEBUG
+#include <assert.h>
+#include "permutation_ga.h"
+
+// ===== Permutation Operators =====
+// OX, PMX and mutation on random survivor subsets must always hand back a
+// permutation of the parents' survivors, keep p1's segment in place and
+// take everything else from p2 the way each operator promises.
+
+#define TRIALS 20000
+
+static void random_genome(Rng* rng, const uint8_t* labels, int count, Permutation* genome) {
+    memcpy(genome->order, labels, count);
+    for (int i = count - 1; i > 0; i--) {
+        int j = (int)rng_range(rng, (uint32_t)(i + 1));
+        uint8_t swap = genome->order[i];
+        genome->order[i] = genome->order[j];
+        genome->order[j] = swap;
+    }
+}
+
+// Survivor labels need not be 0..count-1: any subset of the survivors
+// reachable from the start
+static int random_labels(Rng* rng, uint8_t* labels) {
+    int count = 0;
+    int wanted = 1 + (int)rng_range(rng, MAX_SURVIVORS);
+    for (int s = 0; s < MAX_SURVIVORS; s++) {
+        if ((int)rng_range(rng, MAX_SURVIVORS) < wanted) labels[count++] = (uint8_t)s;
+    }
+    if (count == 0) labels[count++] = (uint8_t)rng_range(rng, MAX_SURVIVORS);
+    return count;
+}
+
+static void assert_permutation(const Permutation* genome, const uint8_t* labels, int count) {
+    int seen[MAX_SURVIVORS] = {0};
+    for (int i = 0; i < count; i++) {
+        assert(genome->order[i] < MAX_SURVIVORS);
+        seen[genome->order[i]]++;
+    }
+    for (int i = 0; i < count; i++) {
+        assert(seen[labels[i]] == 1);
+    }
+}
+
+// Same draws as pick_segment(), from a copy of the generator
+static void peek_segment(Rng rng, int count, int* a, int* b) {
+    *a = (int)rng_range(&rng, (uint32_t)count);
+    *b = (int)rng_range(&rng, (uint32_t)count);
+    if (*a > *b) {
+        int swap = *a;
+        *a = *b;
+        *b = swap;
+    }
+}
+
+static int in_segment(const Permutation* p1, int a, int b, uint8_t survivor) {
+    for (int i = a; i <= b; i++) {
+        if (p1->order[i] == survivor) return 1;
+    }
+    return 0;
+}
+
+static void test_order_crossover(Rng* rng) {
+    uint8_t labels[MAX_SURVIVORS];
+    Permutation p1, p2, child;
+
+    for (int t = 0; t < TRIALS; t++) {
+        int count = random_labels(rng, labels);
+        random_genome(rng, labels, count, &p1);
+        random_genome(rng, labels, count, &p2);
+
+        int a, b;
+        peek_segment(*rng, count, &a, &b);
+        order_crossover(&p1, &p2, &child, count, rng);
+        assert_permutation(&child, labels, count);
+
+        for (int i = a; i <= b; i++) {
+            assert(child.order[i] == p1.order[i]);
+        }
+
+        // The rest wraps around from after the segment, in p2's order
+        int slot = (b + 1) % count;
+        for (int k = 0; k < count; k++) {
+            uint8_t survivor = p2.order[(b + 1 + k) % count];
+            if (in_segment(&p1, a, b, survivor)) continue;
+            assert(child.order[slot] == survivor);
+            slot = (slot + 1) % count;
+        }
+    }
+}
+
+static void test_pmx_crossover(Rng* rng) {
+    uint8_t labels[MAX_SURVIVORS];
+    Permutation p1, p2, child;
+
+    for (int t = 0; t < TRIALS; t++) {
+        int count = random_labels(rng, labels);
+        random_genome(rng, labels, count, &p1);
+        random_genome(rng, labels, count, &p2);
+
+        int a, b;
+        peek_segment(*rng, count, &a, &b);
+        pmx_crossover(&p1, &p2, &child, count, rng);
+        assert_permutation(&child, labels, count);
+
+        for (int i = 0; i < count; i++) {
+            if (i >= a && i <= b) {
+                assert(child.order[i] == p1.order[i]);
+            } else if (!in_segment(&p1, a, b, p2.order[i])) {
+                // Displaced survivors only land where p2 holds a segment survivor
+                assert(child.order[i] == p2.order[i]);
+            }
+        }
+    }
+}
+
+static void test_mutation(Rng* rng) {
+    uint8_t labels[MAX_SURVIVORS];
+    Permutation genome;
+
+    for (int t = 0; t < TRIALS; t++) {
+        int count = random_labels(rng, labels);
+        random_genome(rng, labels, count, &genome);
+        mutate_permutation(&genome, count, 1.0f, rng);
+        assert_permutation(&genome, labels, count);
+    }
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 42);
+
+    test_order_crossover(&rng);
+    test_pmx_crossover(&rng);
+    test_mutation(&rng);
+
+    printf("✓ test_permutation_ga passed\n");
+    return 0;
+}
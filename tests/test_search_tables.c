@@ -0,0 +1,150 @@
+#undef NDEBUG
+#include <assert.h>
+#include "distance_tables.h"
+#include "landmarks.h"
+#include "path_hierarchy.h"
+
+// ===== Incremental Table Updates =====
+// apply_obstacle_deltas() patches the survivor distance tables, the
+// landmark fields and the HPA* hierarchy in place. After random batches of
+// collapses and clearings they must agree with BFS on the changed grid, and
+// the hierarchy with one built from scratch.
+
+#define ROUNDS 30
+#define CLUSTER_SIZE 8
+
+static void bfs_levels(const Grid* grid, int source, int* level, int* queue) {
+    int offsets[NUM_DIRECTIONS];
+    get_neighbor_offsets(grid, offsets);
+    for (int i = 0; i < grid->total_cells; i++) level[i] = -1;
+
+    int head = 0;
+    int tail = 0;
+    level[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        int cell = queue[head++];
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (!(grid->neighbor_mask[cell] & (1 << d))) continue;
+            int next = cell + offsets[d];
+            if (level[next] >= 0) continue;
+            level[next] = level[cell] + 1;
+            queue[tail++] = next;
+        }
+    }
+}
+
+static void check_distance_table(const Grid* grid, int* level, int* queue) {
+    const DistanceTable* table = get_distance_table(grid);
+    for (int s = 0; s < table->num_sources; s++) {
+        bfs_levels(grid, table->source_cell[s], level, queue);
+        for (int u = 0; u < table->num_sources; u++) {
+            assert(source_distance(table, s, u) == level[table->source_cell[u]]);
+        }
+        for (int cell = 0; cell < grid->total_cells; cell++) {
+            if (grid->cell_data[cell] == CELL_OBSTACLE) {
+                assert(direction_to_source(table, s, cell) == DIRECTION_NONE);
+                continue;
+            }
+            assert(walk_distance_to_source(grid, table, cell_coordinate(grid, cell), s, -1) ==
+                   level[cell]);
+        }
+    }
+}
+
+static void check_landmark_table(const Grid* grid, int* level, int* queue) {
+    const LandmarkTable* table = get_landmark_table(grid);
+    for (int l = 0; l < table->count; l++) {
+        bfs_levels(grid, table->cells[l], level, queue);
+        for (int cell = 0; cell < grid->total_cells; cell++) {
+            int expected = level[cell] < 0 || grid->cell_data[cell] == CELL_OBSTACLE
+                ? 0xFFFF : level[cell];
+            assert(table->distance[(size_t)cell * table->count + l] == expected);
+        }
+    }
+}
+
+static void check_hierarchy(const Grid* grid) {
+    const PathHierarchy* patched = get_path_hierarchy(grid);
+    PathHierarchy* fresh = build_path_hierarchy(grid, CLUSTER_SIZE);
+
+    assert(patched->num_nodes == fresh->num_nodes);
+    assert(patched->num_edges == fresh->num_edges);
+    for (int n = 0; n < fresh->num_nodes; n++) {
+        assert(patched->nodes[n].cell == fresh->nodes[n].cell);
+        assert(patched->nodes[n].first_edge == fresh->nodes[n].first_edge);
+        assert(patched->nodes[n].edge_count == fresh->nodes[n].edge_count);
+    }
+    for (int e = 0; e < fresh->num_edges; e++) {
+        assert(patched->edges[e].target == fresh->edges[e].target);
+        assert(patched->edges[e].cost == fresh->edges[e].cost);
+    }
+    free_path_hierarchy(fresh);
+}
+
+// Returns how many of the three tables were patched rather than dropped
+static int test_scenario(Config* config, Rng* rng) {
+    Grid* grid = create_grid(config->grid_x, config->grid_y, config->grid_z);
+    initialize_grid(grid, config);
+    int* level = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int* queue = (int*)safe_malloc(grid->total_cells * sizeof(int));
+    int patched = 0;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        get_distance_table(grid);
+        get_landmark_table(grid);
+        get_path_hierarchy(grid);
+
+        // Mostly small batches, with an occasional large one
+        CellDelta deltas[40];
+        int count = 1 + (int)rng_range(rng, round % 3 == 0 ? 40 : 4);
+        for (int i = 0; i < count; i++) {
+            deltas[i].coord = cell_coordinate(grid, (int)rng_range(rng, (uint32_t)grid->total_cells));
+            deltas[i].blocked = (int)rng_range(rng, 2);
+        }
+        apply_obstacle_deltas(grid, deltas, count);
+
+        patched += grid->distances && grid->distances->grid_version == grid->version;
+        patched += grid->landmarks && grid->landmarks->grid_version == grid->version;
+        patched += grid->hierarchy && grid->hierarchy->grid_version == grid->version;
+
+        check_distance_table(grid, level, queue);
+        check_landmark_table(grid, level, queue);
+        check_hierarchy(grid);
+    }
+
+    free(level);
+    free(queue);
+    free_grid(grid);
+    return patched;
+}
+
+int main(void) {
+    static const char* scenarios[] = {"random", "rubble", "corridors", "floors"};
+    Rng rng;
+    rng_seed(&rng, 32);
+
+    Config* config = create_default_config();
+    config->grid_x = 30;
+    config->grid_y = 25;
+    config->grid_z = 5;
+    config->landmark_count = 8;
+    config->hpa_cluster_size = CLUSTER_SIZE;
+    configure_pathfinding(config);
+
+    int patched = 0;
+    for (int s = 0; s < 4; s++) {
+        for (int percent = 10; percent <= 40; percent += 15) {
+            snprintf(config->scenario_type, sizeof(config->scenario_type), "%s", scenarios[s]);
+            config->obstacle_percent = percent;
+            config->scenario_seed = (unsigned long long)(percent * 7 + s + 1);
+            patched += test_scenario(config, &rng);
+        }
+    }
+    // The incremental paths were taken, not just full rebuilds
+    assert(patched > 0);
+
+    free_config(config);
+    printf("✓ test_search_tables passed\n");
+    return 0;
+}
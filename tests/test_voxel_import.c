@@ -0,0 +1,146 @@
+#undef NDEBUG
+#include <assert.h>
+#include "voxel_import.h"
+
+// ===== Voxel Import =====
+// A random occupancy map written dense and as RLE must import to the same
+// cells and neighbor masks, with the RLE payload read in chunks that split
+// runs anywhere, the 64 KB boundary included. Zero-length runs, runs that
+// cross a row, trailing data and truncated payloads are rejected.
+
+#define SIZE_X 70
+#define SIZE_Y 40
+#define SIZE_Z 30
+#define VOXELS (SIZE_X * SIZE_Y * SIZE_Z)
+#define SURVIVORS 6
+
+static const char* voxel_file = "tests/bin/test_voxel_import.vox";
+static const char* survivor_file = "tests/bin/test_voxel_import.survivors";
+
+// File order: x fastest, then y, then z
+static unsigned char values[VOXELS];
+static unsigned char payload[VOXELS * 2];
+
+static void write_voxel_file(const char* kind, const unsigned char* data, size_t length) {
+    FILE* file = fopen(voxel_file, "wb");
+    assert(file);
+    fprintf(file, "RVOX %s %d %d %d\n", kind, SIZE_X, SIZE_Y, SIZE_Z);
+    fwrite(data, 1, length, file);
+    fclose(file);
+}
+
+// Mostly single-voxel runs, so the payload is well over 64 KB
+static size_t encode_rle(Rng* rng) {
+    size_t length = 0;
+    for (int row = 0; row < VOXELS; row += SIZE_X) {
+        int x = 0;
+        while (x < SIZE_X) {
+            int run = rng_range(rng, 4) == 0 ? 3 : 1;
+            while (x + run < SIZE_X && values[row + x + run] == values[row + x] && run < 255) run++;
+            if (x + run > SIZE_X) run = SIZE_X - x;
+            payload[length++] = (unsigned char)run;
+            payload[length++] = values[row + x];
+            // The run is stored with its first value
+            for (int r = 1; r < run; r++) values[row + x + r] = values[row + x];
+            x += run;
+        }
+    }
+    return length;
+}
+
+static void check_grid(const Grid* grid, const VoxelImportOptions* options) {
+    assert(grid && grid->size_x == SIZE_X && grid->size_y == SIZE_Y && grid->size_z == SIZE_Z);
+    assert(grid->num_survivors == SURVIVORS);
+    int start = cell_index(grid, options->start);
+    int obstacles = 0;
+
+    for (int i = 0; i < VOXELS; i++) {
+        Coordinate c = create_coordinate(i % SIZE_X, i / SIZE_X % SIZE_Y, i / (SIZE_X * SIZE_Y));
+        int index = cell_index(grid, c);
+        CellType expected = values[i] >= options->obstacle_threshold ? CELL_OBSTACLE
+            : values[i] <= options->free_threshold ? CELL_EMPTY
+            : options->unknown_is_obstacle ? CELL_OBSTACLE : CELL_EMPTY;
+        obstacles += expected == CELL_OBSTACLE && index != start;
+        if (index == start) expected = CELL_START;
+        else if (grid->survivor_map[index] >= 0) expected = CELL_SURVIVOR;
+        assert(grid->cell_data[index] == expected);
+        assert(grid->neighbor_mask[index] == compute_neighbor_mask(grid, index));
+    }
+    assert(grid->obstacle_count == obstacles);
+}
+
+static void expect_rejected(const char* kind, const unsigned char* data, size_t length,
+                            const VoxelImportOptions* options) {
+    write_voxel_file(kind, data, length);
+    assert(import_voxel_grid(voxel_file, survivor_file, options) == NULL);
+}
+
+int main(void) {
+    Rng rng;
+    rng_seed(&rng, 26);
+
+    VoxelImportOptions options;
+    options.obstacle_threshold = 200;
+    options.free_threshold = 50;
+    options.unknown_is_obstacle = 1;
+    options.start = create_coordinate(0, 0, 0);
+
+    // Free space with debris, some unknown readings and long open stretches
+    for (int i = 0; i < VOXELS; i++) {
+        int roll = (int)rng_range(&rng, 10);
+        values[i] = roll < 6 ? (unsigned char)rng_range(&rng, 51)
+            : roll < 8 ? 255 : (unsigned char)(51 + rng_range(&rng, 149));
+        if (i / SIZE_X % 7 == 0) values[i] = 0;
+    }
+    size_t rle_length = encode_rle(&rng);
+    assert(rle_length > VOXEL_CHUNK_SIZE);
+
+    FILE* file = fopen(survivor_file, "w");
+    assert(file);
+    fprintf(file, "# survivors\n");
+    for (int s = 0; s < SURVIVORS; s++) {
+        // On the open rows, which every run leaves free
+        int y = (7 - SIZE_Y * s % 7) % 7;
+        fprintf(file, "%d,%d,%d\n", 10 + s, y, s);
+    }
+    fclose(file);
+
+    // Dense and RLE round trips
+    write_voxel_file("dense", values, VOXELS);
+    Grid* grid = import_voxel_grid(voxel_file, survivor_file, &options);
+    check_grid(grid, &options);
+    free_grid(grid);
+
+    // 65535 splits the pair at the 64 KB mark between two reads
+    size_t chunks[] = {VOXEL_CHUNK_SIZE, VOXEL_CHUNK_SIZE - 1, 1, 7, 4096};
+    write_voxel_file("rle", payload, rle_length);
+    for (int c = 0; c < 5; c++) {
+        grid = import_voxel_grid_chunked(voxel_file, survivor_file, &options, chunks[c]);
+        check_grid(grid, &options);
+        free_grid(grid);
+    }
+
+    // Trailing data
+    static unsigned char dense[VOXELS + 1];
+    memcpy(dense, values, VOXELS);
+    expect_rejected("dense", dense, VOXELS + 1, &options);
+    payload[rle_length] = 1;
+    payload[rle_length + 1] = 0;
+    expect_rejected("rle", payload, rle_length + 2, &options);
+
+    // Truncated: a voxel short, a pair short, a value byte short
+    expect_rejected("dense", dense, VOXELS - 1, &options);
+    expect_rejected("rle", payload, rle_length - 2, &options);
+    expect_rejected("rle", payload, rle_length - 1, &options);
+
+    // A zero-length run, and a run longer than what is left of its row
+    unsigned char zero_run[] = {0, 0, SIZE_X, 0};
+    expect_rejected("rle", zero_run, sizeof(zero_run), &options);
+    unsigned char crossing[] = {SIZE_X - 5, 0, 10, 0};
+    expect_rejected("rle", crossing, sizeof(crossing), &options);
+
+    remove(voxel_file);
+    remove(survivor_file);
+    printf("✓ test_voxel_import passed\n");
+    return 0;
+}
@@ -1,108 +1,172 @@
-#ifndef UTILITIES_H
-#define UTILITIES_H
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>
-#include <math.h>
-#include <unistd.h>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <sys/ipc.h>
-#include <sys/shm.h>
-#include <sys/sem.h>
-#include <errno.h>
-#include <pthread.h>
-
-// ===== Constants =====
-#define MAX_PATH_LENGTH 1000
-#define MAX_LINE_LENGTH 256
-#define MAX_SURVIVORS 50
-#define MAX_POPULATION 500
-#define CONFIG_FILE_DEFAULT "config/config.txt"
-#define OUTPUT_FILE "output/results.txt"
-
-// ===== Data Structures =====
-
-// 3D Coordinate structure
-typedef struct {
-    int x;
-    int y;
-    int z;
-} Coordinate;
-
-// Cell types in the grid
-typedef enum {
-    CELL_EMPTY = 0,      // Empty space
-    CELL_OBSTACLE = 1,   // Debris/obstacle
-    CELL_SURVIVOR = 2,   // Survivor location
-    CELL_START = 3       // Robot starting position
-} CellType;
-
-// Configuration parameters
-typedef struct {
-    // Grid settings
-    int grid_x;
-    int grid_y;
-    int grid_z;
-    int num_survivors;
-    int obstacle_percent;
-    Coordinate start_pos;
-    
-    // GA parameters
-    int population_size;
-    int max_generations;
-    float mutation_rate;
-    float crossover_rate;
-    int elitism_percent;
-    int tournament_size;
-    
-    // Fitness weights
-    float w1_survivors;
-    float w2_coverage;
-    float w3_length;
-    float w4_risk;
-    
-    // Multi-processing
-    int num_workers;
-    
-    // Termination criteria
-    int stagnation_limit;
-    int time_limit;
-    
-    // Output settings
-    int verbose;
-    int save_stats;
-} Config;
-
-// ===== Function Prototypes =====
-
-// Configuration functions
-Config* load_config(const char* filename);
-Config* create_default_config();
-void print_config(const Config* config);
-void free_config(Config* config);
-int validate_config(Config* config);
-
-// Utility functions
-int random_int(int min, int max);
-float random_float(float min, float max);
-double get_time_ms();
-void print_progress_bar(int current, int total, const char* label);
-
-// Coordinate functions
-Coordinate create_coordinate(int x, int y, int z);
-int coordinates_equal(Coordinate c1, Coordinate c2);
-float distance_3d(Coordinate c1, Coordinate c2);
-int manhattan_distance(Coordinate c1, Coordinate c2);
-
-// Memory management
-void* safe_malloc(size_t size);
-void* safe_calloc(size_t count, size_t size);
-
-// Error handling
-void error_exit(const char* message);
-void warning(const char* message);
-
-#endif // UTILITIES_H
+#ifndef UTILITIES_H
+#define UTILITIES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/sem.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+
+// ===== Constants =====
+#define MAX_PATH_LENGTH 1000
+#define MAX_LINE_LENGTH 256
+#define MAX_SURVIVORS 50
+#define MAX_GRID_XY 500
+#define MAX_GRID_Z 30
+#define MAX_POPULATION 500
+#define MAX_PERMUTATION_POPULATION 100000
+#define CONFIG_FILE_DEFAULT "config/config.txt"
+#define OUTPUT_FILE "output/results.txt"
+
+// ===== Data Structures =====
+
+// 3D Coordinate structure
+typedef struct {
+    int x;
+    int y;
+    int z;
+} Coordinate;
+
+// Cell types in the grid
+typedef enum {
+    CELL_EMPTY = 0,      // Empty space
+    CELL_OBSTACLE = 1,   // Debris/obstacle
+    CELL_SURVIVOR = 2,   // Survivor location
+    CELL_START = 3       // Robot starting position
+} CellType;
+
+// Seeded random stream: xoshiro256** (256 bits of state, no global state)
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+// Stream ids: a domain in the top byte, then two caller indices, so every
+// individual draws from its own stream whichever process handles it
+#define RNG_DOMAIN_MASTER 0
+#define RNG_DOMAIN_SCENARIO 1
+#define RNG_DOMAIN_INITIAL 2       // minor = population slot
+#define RNG_DOMAIN_BREED 3         // major = generation, minor = child slot
+#define RNG_DOMAIN_PERMUTATION 4
+#define RNG_DOMAIN_WORKER 5        // minor = worker id
+
+static inline uint64_t rng_stream_id(int domain, uint32_t major, uint32_t minor) {
+    return (uint64_t)domain << 56 | (uint64_t)(major & 0xFFFFFFu) << 32 | minor;
+}
+
+// Configuration parameters
+typedef struct {
+    // Grid settings
+    int grid_x;
+    int grid_y;
+    int grid_z;
+    int num_survivors;
+    int obstacle_percent;
+    Coordinate start_pos;
+    
+    // Voxel map import (empty voxel_file = random layout)
+    char voxel_file[MAX_LINE_LENGTH];
+    char survivor_file[MAX_LINE_LENGTH];
+    int voxel_obstacle_threshold;   // Occupancy >= threshold is an obstacle
+    int voxel_free_threshold;       // Occupancy <= threshold is free space
+    int voxel_unknown_obstacle;     // Treat values in between as obstacles
+    
+    // Master random seed: every stream (scenario, initial paths, breeding)
+    // derives from it, so a seed reproduces a run for any worker count
+    unsigned long long seed;            // 0 = pick from clock and report it
+    
+    // Procedural scenario (used when no voxel map is given)
+    unsigned long long scenario_seed;   // 0 = derive from the master seed
+    char scenario_type[32];             // random | rubble | corridors | floors
+    
+    // GA parameters
+    int genome;                     // 0 = coordinate path, 1 = survivor permutation
+    int population_size;
+    int max_generations;
+    float mutation_rate;
+    float crossover_rate;
+    int elitism_percent;
+    int tournament_size;
+    int memetic_top_k;              // Best paths locally searched per generation; 0 = off
+    int adaptive_operators;         // 1 = pick operators by gain per unit of work (default, see operator_selection.h)
+    
+    // Fitness weights
+    float w1_survivors;
+    float w2_coverage;
+    float w3_length;
+    float w4_risk;
+    
+    // Pathfinding
+    int astar_queue;                // 0 = binary heap, 1 = Dial bucket queue
+    int pathfinder;                 // 0 = A*, 1 = jump point search, 2 = hierarchical
+    int hpa_cluster_size;           // Cluster side length for hierarchical search
+    int hpa_min_cells;              // Smaller grids use A* even with PATHFINDER=hpa
+    int landmark_count;             // ALT landmarks for the A* heuristic; 0 = off
+    int bidirectional_threshold;    // Connectors this far apart (Manhattan) use bidirectional A*; 0 = calibrate, -1 = off
+    int connector_cache_size;       // Shared connector cache entries; 0 = off
+    
+    // Multi-processing
+    int num_workers;
+    
+    // Dynamic collapse events (file path, "-" for stdin, empty = none)
+    char events_file[MAX_LINE_LENGTH];
+    
+    // Termination criteria
+    int stagnation_limit;
+    int time_limit;
+    
+    // Output settings
+    int verbose;
+    int save_stats;
+} Config;
+
+// ===== Function Prototypes =====
+
+// Configuration functions
+Config* load_config(const char* filename);
+Config* create_default_config();
+void print_config(const Config* config);
+void free_config(Config* config);
+int validate_config(Config* config);
+
+// Utility functions
+// random_int/random_float draw from the calling thread's stream, which
+// seed_random() points at (seed, stream)
+void seed_random(uint64_t seed, uint64_t stream);
+Rng* random_stream(void);
+uint64_t resolve_seed(Config* config);
+int random_int(int min, int max);
+float random_float(float min, float max);
+double get_time_ms();
+void print_progress_bar(int current, int total, const char* label);
+
+// Seeded random streams
+void rng_seed(Rng* rng, uint64_t seed);
+void rng_seed_stream(Rng* rng, uint64_t seed, uint64_t stream);
+uint64_t rng_next(Rng* rng);
+uint32_t rng_range(Rng* rng, uint32_t bound);
+float rng_float(Rng* rng);
+
+// Coordinate functions
+Coordinate create_coordinate(int x, int y, int z);
+int coordinates_equal(Coordinate c1, Coordinate c2);
+float distance_3d(Coordinate c1, Coordinate c2);
+int manhattan_distance(Coordinate c1, Coordinate c2);
+
+// Memory management
+void* safe_malloc(size_t size);
+void* safe_calloc(size_t count, size_t size);
+
+// Error handling
+void error_exit(const char* message);
+void warning(const char* message);
+
+#endif // UTILITIES_H
@@ -0,0 +1,302 @@
+#include "voxel_import.h"
+#include "path_encoding.h"
+#include <limits.h>
+
+// ===== Import State =====
+
+// Write cursor for the streaming pass (file order: x fastest, then y, then z)
+typedef struct {
+    int x, y, z;
+    long long decoded;          // Voxels written so far
+    int row_remaining;          // RLE: voxels left in the current row
+    int pending_count;          // RLE: run length waiting for its value byte
+    int start_index;            // Cell index of the robot start
+    int start_blocked;          // Start voxel was classified as obstacle
+} ImportState;
+
+// ===== Options =====
+
+VoxelImportOptions voxel_options_from_config(const Config* config) {
+    VoxelImportOptions options;
+    options.obstacle_threshold = config->voxel_obstacle_threshold;
+    options.free_threshold = config->voxel_free_threshold;
+    options.unknown_is_obstacle = config->voxel_unknown_obstacle;
+    options.start = config->start_pos;
+    return options;
+}
+
+// ===== Cell Classification =====
+
+static CellType classify_voxel(unsigned char value, const VoxelImportOptions* options) {
+    if (value >= options->obstacle_threshold) return CELL_OBSTACLE;
+    if (value <= options->free_threshold) return CELL_EMPTY;
+    return options->unknown_is_obstacle ? CELL_OBSTACLE : CELL_EMPTY;
+}
+
+// Set the mutual mask bits between a new cell and an earlier neighbor
+static void link_backward(Grid* grid, int index, int neighbor, int dir_to_neighbor,
+                          int dir_back, int walkable) {
+    if (grid->cell_data[neighbor] != CELL_OBSTACLE) {
+        grid->neighbor_mask[index] |= (unsigned char)(1 << dir_to_neighbor);
+    }
+    if (walkable) {
+        grid->neighbor_mask[neighbor] |= (unsigned char)(1 << dir_back);
+    }
+}
+
+// Store one voxel and link neighbor masks with the already-decoded
+// neighbors (-x, -y, -z), so the masks are complete after a single pass
+static void emit_voxel(Grid* grid, ImportState* st, unsigned char value,
+                       const VoxelImportOptions* options) {
+    int stride_x = grid->size_y * grid->size_z;
+    int stride_y = grid->size_z;
+    int index = st->x * stride_x + st->y * stride_y + st->z;
+
+    CellType type = classify_voxel(value, options);
+    if (index == st->start_index) {
+        if (type == CELL_OBSTACLE) st->start_blocked = 1;
+        type = CELL_START;
+    }
+    grid->cell_data[index] = type;
+
+    // Obstacle cells keep a mask too (paths may pass through debris)
+    int walkable = (type != CELL_OBSTACLE);
+    if (!walkable) grid->obstacle_count++;
+
+    if (st->x > 0) link_backward(grid, index, index - stride_x, DIR_NEG_X, DIR_POS_X, walkable);
+    if (st->y > 0) link_backward(grid, index, index - stride_y, DIR_NEG_Y, DIR_POS_Y, walkable);
+    if (st->z > 0) link_backward(grid, index, index - 1, DIR_NEG_Z, DIR_POS_Z, walkable);
+
+    st->decoded++;
+    if (++st->x == grid->size_x) {
+        st->x = 0;
+        if (++st->y == grid->size_y) {
+            st->y = 0;
+            st->z++;
+        }
+    }
+}
+
+// ===== Chunk Decoders =====
+
+static int decode_dense_chunk(Grid* grid, ImportState* st, const unsigned char* buf,
+                              size_t len, const VoxelImportOptions* options) {
+    for (size_t i = 0; i < len; i++) {
+        if (st->decoded >= grid->total_cells) {
+            warning("Voxel file has trailing data after the last voxel");
+            return 0;
+        }
+        emit_voxel(grid, st, buf[i], options);
+    }
+    return 1;
+}
+
+static int decode_rle_chunk(Grid* grid, ImportState* st, const unsigned char* buf,
+                            size_t len, const VoxelImportOptions* options) {
+    for (size_t i = 0; i < len; i++) {
+        if (st->pending_count == 0) {
+            // Run length byte
+            if (buf[i] == 0) {
+                warning("Voxel RLE run of length 0");
+                return 0;
+            }
+            st->pending_count = buf[i];
+            continue;
+        }
+
+        // Value byte completes the run
+        if (st->decoded >= grid->total_cells) {
+            warning("Voxel file has trailing data after the last voxel");
+            return 0;
+        }
+        if (st->pending_count > st->row_remaining) {
+            warning("Voxel RLE run crosses a row boundary");
+            return 0;
+        }
+        for (int r = 0; r < st->pending_count; r++) {
+            emit_voxel(grid, st, buf[i], options);
+        }
+        st->row_remaining -= st->pending_count;
+        if (st->row_remaining == 0) {
+            st->row_remaining = grid->size_x;
+        }
+        st->pending_count = 0;
+    }
+    return 1;
+}
+
+// ===== Header Parsing =====
+
+static int read_voxel_header(FILE* file, VoxelFormat* format,
+                             int* size_x, int* size_y, int* size_z) {
+    char line[MAX_LINE_LENGTH];
+    char magic[16], kind[16];
+
+    if (!fgets(line, sizeof(line), file)) {
+        warning("Voxel file is empty");
+        return 0;
+    }
+
+    if (sscanf(line, "%15s %15s %d %d %d", magic, kind, size_x, size_y, size_z) != 5 ||
+        strcmp(magic, VOXEL_MAGIC) != 0) {
+        warning("Invalid voxel header (expected: RVOX <dense|rle> X Y Z)");
+        return 0;
+    }
+
+    if (strcmp(kind, "dense") == 0) *format = VOXEL_DENSE;
+    else if (strcmp(kind, "rle") == 0) *format = VOXEL_RLE;
+    else {
+        warning("Unknown voxel encoding (expected dense or rle)");
+        return 0;
+    }
+
+    if (*size_x <= 0 || *size_y <= 0 || *size_z <= 0 ||
+        (long long)*size_x * *size_y * *size_z > INT_MAX) {
+        warning("Invalid voxel grid dimensions");
+        return 0;
+    }
+
+    // Paths travel between processes as int16 move codes
+    if (*size_x - 1 > MAX_ENCODED_COORDINATE || *size_y - 1 > MAX_ENCODED_COORDINATE ||
+        *size_z - 1 > MAX_ENCODED_COORDINATE) {
+        warning("Voxel grid axes are limited to 32768 cells");
+        return 0;
+    }
+
+    return 1;
+}
+
+// ===== Survivor List =====
+
+int load_survivor_list(Grid* grid, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        warning("Could not open survivor list file");
+        return 0;
+    }
+
+    if (!grid->survivors) {
+        grid->survivors = (Coordinate*)safe_malloc(MAX_SURVIVORS * sizeof(Coordinate));
+    }
+    grid->num_survivors = 0;
+
+    char line[MAX_LINE_LENGTH];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') {
+            continue;
+        }
+
+        for (char* p = line; *p; p++) {
+            if (*p == ',') *p = ' ';
+        }
+
+        Coordinate coord;
+        if (sscanf(line, "%d %d %d", &coord.x, &coord.y, &coord.z) != 3) {
+            fprintf(stderr, "WARNING: Survivor list line %d is malformed, skipping\n",
+                    line_number);
+            continue;
+        }
+
+        if (grid->num_survivors >= MAX_SURVIVORS) {
+            fprintf(stderr, "WARNING: More than %d survivors listed, ignoring the rest\n",
+                    MAX_SURVIVORS);
+            break;
+        }
+
+        if (!is_valid_coordinate(grid, coord) || get_cell(grid, coord) != CELL_EMPTY) {
+            fprintf(stderr, "WARNING: Survivor at (%d, %d, %d) is out of bounds or "
+                    "not on free space, skipping\n", coord.x, coord.y, coord.z);
+            continue;
+        }
+
+        int index = cell_index(grid, coord);
+        grid->cell_data[index] = CELL_SURVIVOR;
+        grid->survivor_map[index] = (signed char)grid->num_survivors;
+        grid->survivors[grid->num_survivors++] = coord;
+    }
+
+    fclose(file);
+    return grid->num_survivors;
+}
+
+// ===== Streaming Import =====
+
+Grid* import_voxel_grid(const char* voxel_file, const char* survivor_file,
+                        const VoxelImportOptions* options) {
+    return import_voxel_grid_chunked(voxel_file, survivor_file, options, VOXEL_CHUNK_SIZE);
+}
+
+Grid* import_voxel_grid_chunked(const char* voxel_file, const char* survivor_file,
+                                const VoxelImportOptions* options, size_t chunk_size) {
+    FILE* file = fopen(voxel_file, "rb");
+    if (!file) {
+        warning("Could not open voxel file");
+        return NULL;
+    }
+
+    VoxelFormat format;
+    int size_x, size_y, size_z;
+    if (!read_voxel_header(file, &format, &size_x, &size_y, &size_z)) {
+        fclose(file);
+        return NULL;
+    }
+
+    Coordinate start = options->start;
+    if (start.x < 0 || start.x >= size_x || start.y < 0 || start.y >= size_y ||
+        start.z < 0 || start.z >= size_z) {
+        warning("Start position outside voxel map, using (0,0,0)");
+        start = create_coordinate(0, 0, 0);
+    }
+
+    double import_start = get_time_ms();
+    Grid* grid = create_grid(size_x, size_y, size_z);
+    grid->start = start;
+
+    ImportState st;
+    memset(&st, 0, sizeof(st));
+    st.row_remaining = size_x;
+    st.start_index = cell_index(grid, start);
+
+    // Stream the payload in fixed-size chunks
+    unsigned char* buffer = (unsigned char*)safe_malloc(chunk_size);
+    int ok = 1;
+    size_t bytes;
+    while (ok && (bytes = fread(buffer, 1, chunk_size, file)) > 0) {
+        if (format == VOXEL_DENSE) {
+            ok = decode_dense_chunk(grid, &st, buffer, bytes, options);
+        } else {
+            ok = decode_rle_chunk(grid, &st, buffer, bytes, options);
+        }
+    }
+    free(buffer);
+    fclose(file);
+
+    if (ok && (st.decoded != grid->total_cells || st.pending_count != 0)) {
+        warning("Voxel file ended before all voxels were read");
+        ok = 0;
+    }
+    if (!ok) {
+        free_grid(grid);
+        return NULL;
+    }
+
+    if (st.start_blocked) {
+        warning("Start voxel is occupied in the scan, treating it as free");
+    }
+
+    if (load_survivor_list(grid, survivor_file) == 0) {
+        warning("No valid survivors loaded from survivor list");
+        free_grid(grid);
+        return NULL;
+    }
+
+    label_components(grid);
+
+    printf("✓ Imported %dx%dx%d voxel map (%s) in %.1f ms\n",
+           size_x, size_y, size_z, format == VOXEL_DENSE ? "dense" : "rle",
+           get_time_ms() - import_start);
+
+    return grid;
+}
@@ -0,0 +1,43 @@
+#ifndef VOXEL_IMPORT_H
+#define VOXEL_IMPORT_H
+
+#include "utilities.h"
+#include "grid_environment.h"
+
+// ===== Voxel File Format =====
+// Header line:  RVOX <dense|rle> <size_x> <size_y> <size_z>
+// followed by a binary payload of occupancy values (0-255), ordered
+// layer by layer (z), row by row (y), with x varying fastest.
+//   dense - one byte per voxel
+//   rle   - each row is a sequence of (count, value) byte pairs whose
+//           counts (1-255) sum to size_x; runs never cross a row
+//
+// Survivor list: one "x y z" (or "x,y,z") triple per line, '#' comments.
+
+#define VOXEL_MAGIC "RVOX"
+#define VOXEL_CHUNK_SIZE 65536
+
+typedef enum {
+    VOXEL_DENSE = 0,
+    VOXEL_RLE = 1
+} VoxelFormat;
+
+// Occupancy classification and start cell for an import
+typedef struct {
+    int obstacle_threshold;     // value >= threshold -> obstacle
+    int free_threshold;         // value <= threshold -> empty
+    int unknown_is_obstacle;    // values in between -> obstacle if set
+    Coordinate start;           // Robot start (always forced walkable)
+} VoxelImportOptions;
+
+// ===== Import Functions =====
+VoxelImportOptions voxel_options_from_config(const Config* config);
+Grid* import_voxel_grid(const char* voxel_file, const char* survivor_file,
+                        const VoxelImportOptions* options);
+// Same, reading the payload 'chunk_size' bytes at a time (an odd size
+// splits RLE pairs between chunks)
+Grid* import_voxel_grid_chunked(const char* voxel_file, const char* survivor_file,
+                                const VoxelImportOptions* options, size_t chunk_size);
+int load_survivor_list(Grid* grid, const char* filename);
+
+#endif // VOXEL_IMPORT_H